@@ -40,6 +40,10 @@ class Enum:
     throw_exceptions = True
     # generate fromString for string_view
     string_view = True
+    """
+    define the functions as constexpr in the header instead of the source file
+    """
+    constexpr = False
     def __init__(self, startLine:int, name:str, numbers:list[int], names:list[str], namespace:str=""):
         self.startLine = startLine
         self.name = name
@@ -52,13 +56,23 @@ class Enum:
         check if the enum is a continous range
         returns: bool, min, max
         """
-        sorted_numbers = self.numbers.copy()
-        sorted_numbers.sort()
-        if sorted_numbers == range(sorted_numbers[0], sorted_numbers[-1]+1, 1):
+        sorted_numbers = sorted(set(self.numbers))
+        if sorted_numbers == list(range(sorted_numbers[0], sorted_numbers[-1]+1)):
             return True, sorted_numbers[0], sorted_numbers[-1]
         else:
             return False, -1, -1
 
+    def get_unique_values(self) -> list[tuple[int, str]]:
+        """
+        returns (number, name) for every value, sorted by number.
+        if multiple names have the same number, only the first one is used
+        """
+        values = {}
+        for number, name in zip(self.numbers, self.names):
+            if number not in values:
+                values[number] = name
+        return sorted(values.items())
+
     def get_name(self):
         if self.namespace:
             return self.namespace + "::" + self.name
@@ -78,6 +92,9 @@ class Enum:
         if len(s) > 2: return s[:-1]
         else: return s
 
+    def get_specifier(self) -> str:
+        return "constexpr " if Enum.constexpr else ""
+
     def get_dec_toString(self) -> str:
         """
         return the declaration for the toString method
@@ -85,17 +102,21 @@ class Enum:
         s = ""
         if Enum.include_docstrings:
             s += "/**\n"
-            s += f' * @brief Convert @ref {self.get_name()} "an enumeration value" to std::string\n'
+            s += f' * @brief Convert @ref {self.get_name()} "an enumeration value" to std::string_view\n'
             s += f' * @details\n'
             if Enum.docstring_include_generated:
                 s += f' *  This function was generated by gen_enum_str.py\\n\n'
+                s += f' *  The returned string_view points to a static string.\n'
                 if Enum.throw_exceptions:
                     s += f' *  Throws gz::InvalidArgument if v is invalid.\n'
                     s += f' * @throws gz::InvalidArgument if v is invalid.\n'
                 else:
                     s += f' * Returns an empty string if v is invalid.\n'
             s += f' */\n'
-        s += f"std::string toString(const {self.get_name()}& v);\n"
+        if Enum.constexpr:
+            s += self.get_def_toString()
+        else:
+            s += f"std::string_view toString(const {self.get_name()}& v);\n"
         return s
 
     def get_dec_fromString(self) -> str:
@@ -115,20 +136,44 @@ class Enum:
             s += f' * @details\n'
             if Enum.docstring_include_generated:
                 s += f' *  This function was generated by gen_enum_str.py\\n\n'
+                s += f' *  The string is matched by switching on its length and on distinguishing characters, and then compared once.\n'
                 if Enum.throw_exceptions:
                     s += f' *  Throws gz::InvalidArgument if s is invalid.\n'
                     s += f' * @throws gz::InvalidArgument if s is invalid.\n'
                 else:
                     s += f' * Returns {self.get_name()}::{self.names[-1]} if s is invalid.\n'
                 if Enum.docstring_include_names:
-                    s += f' * @param v one of: {self.get_names_for_doc()}\n'
+                    s += f' * @param s one of: {self.get_names_for_doc()}\n'
             s += f' */\n'
-        s += f"template<> {self.get_name()} fromString<{self.get_name()}>(const std::string& s);\n"
+        if Enum.constexpr:
+            s += self.get_def_fromString()
+        else:
+            s += f"template<> {self.get_name()} fromString<{self.get_name()}>(const std::string& s);\n"
+            if Enum.string_view:
+                if Enum.include_docstrings:
+                    s += f'/// @brief Convert a std::string_view to @ref {self.get_name()} "an enumeration value"\n'
+                s += f"template<> {self.get_name()} fromString<{self.get_name()}>(const std::string_view& sv);\n"
+        return s
 
-        if Enum.string_view:
-            if Enum.include_docstrings:
-                s += '/// @brief Convert a std::string_view to @ref {self.get_name()} "an enumeration value"\n'
-            s += f"template<> {self.get_name()} fromString<{self.get_name()}>(const std::string_view& sv);\n"
+    def get_switch(self, candidates:list[str], indent:str) -> str:
+        """
+        return nested switch statements that set v to the value whose name equals sv.
+        candidates all have the same length, on every level the position with the most different chars is used,
+        until only a single candidate is left, which is then compared with sv.
+        """
+        if len(candidates) == 1:
+            return f'{indent}if (sv == "{candidates[0]}") {{ v = {self.get_name()}::{candidates[0]}; return true; }}\n'
+        length = len(candidates[0])
+        position = max(range(length), key=lambda i: len(set(name[i] for name in candidates)))
+        buckets = {}
+        for name in candidates:
+            buckets.setdefault(name[position], []).append(name)
+        s = f"{indent}switch (sv[{position}]) {{\n"
+        for c, bucket in sorted(buckets.items()):
+            s += f"{indent}    case '{c}':\n"
+            s += self.get_switch(bucket, indent + "        ")
+            s += f"{indent}        break;\n"
+        s += f"{indent}}}\n"
         return s
 
     def get_def_struct(self) -> str:
@@ -136,59 +181,78 @@ class Enum:
         return the definition of the EnumStringConversion struct
         """
         s = ""
-        s += f"// Holds maps used by fromString and toString for conversion of {self.name} values\n"
+        s += f"// Holds the name table and lookup used by fromString and toString for conversion of {self.name} values\n"
         s += f"struct {self.get_struct_name()}" + " {\n"
-        s += f"    static gz::util::unordered_string_map<{self.get_name()}> name2type;\n"
-        s += f"    static std::map<{self.get_name()}, std::string> type2name;\n"
-        s += "};  // generated by gen_enum_str\n\n"
-
-        # name2type
-        s += f"gz::util::unordered_string_map<{self.get_name()}> {self.get_struct_name()}::name2type " + "{\n"
-        for i in range(len(self.names)):
-            # { "ENUM_VAL", namespace::ENUM_NAME::ENUM_VAL },
-            s += '\t{ "' + self.names[i] + '", ' + self.get_name() + "::" + self.names[i] + " },\n"
-        s += "};  // generated by gen_enum_str\n\n"
-
-        # type2name
-        s += f"std::map<{self.get_name()}, std::string> {self.get_struct_name()}::type2name " + "{\n"
-        for i in range(len(self.names)):
-            # { namespace::ENUM_NAME::ENUM_VAL, "ENUM_VAL", },
-            s += '\t{ ' + self.get_name() + "::" + self.names[i] + ', "' + self.names[i] + '" },\n'
+        is_range, first, last = self.is_range()
+        if is_range:
+            # names indexed by value - first
+            s += f"    static constexpr long long first = {first};\n"
+            s += f"    static constexpr std::string_view names[] = " + "{\n"
+            for number, name in self.get_unique_values():
+                s += f'        "{name}",\n'
+            s += "    };\n"
+        # fromString: switch on the length, then on distinguishing chars
+        by_length = {}
+        for name in self.names:
+            by_length.setdefault(len(name), []).append(name)
+        s += f"    static constexpr bool find(std::string_view sv, {self.get_name()}& v) " + "{\n"
+        s += f"        switch (sv.size()) " + "{\n"
+        for length, candidates in sorted(by_length.items()):
+            s += f"            case {length}:\n"
+            s += self.get_switch(candidates, "                ")
+            s += f"                break;\n"
+        s += "        }\n"
+        s += "        return false;\n"
+        s += "    }\n"
         s += "};  // generated by gen_enum_str\n\n"
         return s
 
     def get_def_toString(self) -> str:
         s = ""
-        s += f"std::string toString(const {self.get_name()}& v) " + "{\n"
-        s += f"\tif ({self.get_struct_name()}::type2name.contains(v)) " + "{\n"
-        s += f"\t\treturn {self.get_struct_name()}::type2name.at(v);\n"
-        s +=  "\t}\n"
-        s +=  "\telse {\n"
         if Enum.throw_exceptions:
-            s += f'\t\tthrow gz::InvalidArgument("InvalidArgument: \'" + std::to_string(static_cast<int>(v)) + "\'", "toString({self.name})");\n'
+            invalid = f'\tthrow gz::InvalidArgument("InvalidArgument: \'" + std::to_string(static_cast<long long>(v)) + "\'", "toString({self.name})");\n'
         else:
-            s += f'\t\treturn "";\n'
-        s +=  "\t}\n"
+            invalid = f'\treturn "";\n'
+        s += f"{self.get_specifier()}std::string_view toString(const {self.get_name()}& v) " + "{\n"
+        is_range, first, last = self.is_range()
+        if is_range:
+            s += f"\tconst long long i = static_cast<long long>(v) - {self.get_struct_name()}::first;\n"
+            s += f"\tif (i >= 0 and i < static_cast<long long>(std::size({self.get_struct_name()}::names))) " + "{\n"
+            s += f"\t\treturn {self.get_struct_name()}::names[i];\n"
+            s +=  "\t}\n"
+        else:
+            s += "\tswitch (v) {\n"
+            for number, name in self.get_unique_values():
+                s += f'\t\tcase {self.get_name()}::{name}: return "{name}";\n'
+            s += "\t\tdefault: break;\n"
+            s += "\t}\n"
+        s += invalid
         s +=  "}  // generated by gen_enum_str\n\n"
         return s
 
     def get_def_fromString(self) -> str:
         s = ""
         # string_view
-        s += f"template<> {self.get_name()} fromString<{self.get_name()}>(const std::string_view& sv) " + "{\n"
-        s += f"\tif ({self.get_struct_name()}::name2type.contains(sv)) " + "{\n"
-        s += f"\t\treturn {self.get_struct_name()}::name2type.find(sv)->second;\n"
+        name = self.get_name()
+        if Enum.string_view:
+            s += f"template<> {self.get_specifier()}{name} fromString<{name}>(const std::string_view& sv) " + "{\n"
+        else:
+            s += f"static {self.get_specifier()}{name} fromStringView_{self.name}(std::string_view sv) " + "{\n"
+        s += f"\t{name} v" + "{};\n"
+        s += f"\tif ({self.get_struct_name()}::find(sv, v)) " + "{\n"
+        s += f"\t\treturn v;\n"
         s +=  "\t}\n"
-        s +=  "\telse {\n"
         if Enum.throw_exceptions:
-            s += f'\t\tthrow gz::InvalidArgument("InvalidArgument: \'" + std::string(sv) + "\'", "fromString<{self.name}>");\n'
+            s += f'\tthrow gz::InvalidArgument("InvalidArgument: \'" + std::string(sv) + "\'", "fromString<{self.name}>");\n'
         else:
-            s += f'\t\treturn {self.get_name()}::{self.names[-1]};\n'
-        s +=  "\t}\n"
+            s += f'\treturn {name}::{self.names[-1]};\n'
         s +=  "}  // generated by gen_enum_str\n\n"
         # string
-        s += f"template<> {self.get_name()} fromString<{self.get_name()}>(const std::string& s) " + "{\n"
-        s += f"\treturn fromString<{self.get_name()}>(std::string_view(s));\n"
+        s += f"template<> {self.get_specifier()}{name} fromString<{name}>(const std::string& s) " + "{\n"
+        if Enum.string_view:
+            s += f"\treturn fromString<{name}>(std::string_view(s));\n"
+        else:
+            s += f"\treturn fromStringView_{self.name}(s);\n"
         s +=  "}  // generated by gen_enum_str\n\n"
         return s
 
@@ -204,15 +268,17 @@ def append_enums_to_files(header_file:str, source_file:str, enums: list[Enum], i
 
     print("append_enums_to_files:", header_file, source_file)
     if not path.isfile(header_file): error("File does not exist:" + header_file)
-    if not path.isfile(source_file):
+    if not path.isfile(source_file) and not Enum.constexpr:
         print("Creating source_file: " + source_file)
         with open(source_file, "w") as file:
-            file.write(f'// generated by gen_enum_str\n#include "{header_file}"\n\n#include <gz-util/util/string.hpp>\n\n')
+            file.write(f'// generated by gen_enum_str\n#include "{header_file}"\n\n#include <gz-util/string/conversion.hpp>\n#include <gz-util/exceptions.hpp>\n\n')
 
     with open(header_file, "r") as file:
         header = file.read()
-    with open(source_file, "r") as file:
-        source = file.read()
+    source = None
+    if path.isfile(source_file):
+        with open(source_file, "r") as file:
+            source = file.read()
 
     # delete everything between the two comments
     comment_gen_begin = "// ENUM - STRING CONVERSION BEGIN\n"
@@ -223,36 +289,47 @@ def append_enums_to_files(header_file:str, source_file:str, enums: list[Enum], i
     if gen_begin > 0 and gen_end > gen_begin:
         header = header[:gen_begin - 1] + header[gen_end + len(comment_gen_end):]
 
-    gen_begin = source.find(comment_gen_begin)
-    gen_end = source.find(comment_gen_end)
-    if gen_begin > 0 and gen_end > gen_begin:
-        source = source[:gen_begin - 1] + source[gen_end + len(comment_gen_end):]
+    if source is not None:
+        gen_begin = source.find(comment_gen_begin)
+        gen_end = source.find(comment_gen_end)
+        if gen_begin > 0 and gen_end > gen_begin:
+            source = source[:gen_begin - 1] + source[gen_end + len(comment_gen_end):]
 
     header += "\n" + comment_gen_begin
     header += "// do not write your own code between these comment blocks - it will be overwritten when you run gen_enum_str.py again\n"
-    source += "\n" + comment_gen_begin
-    source += "// do not write your own code between these comment blocks - it will be overwritten when you run gen_enum_str.py again\n"
+    header += "#include <concepts>\n#include <iterator>\n#include <string>\n#include <string_view>\n"
+    if Enum.constexpr and Enum.throw_exceptions:
+        header += "#include <gz-util/exceptions.hpp>\n"
+    # with --constexpr, everything goes into the header and the generated block is removed from the source
+    if not Enum.constexpr:
+        source += "\n" + comment_gen_begin
+        source += "// do not write your own code between these comment blocks - it will be overwritten when you run gen_enum_str.py again\n"
     for enum in enums:
         if interactive:
             answer = input(f"Generate conversion for: {header_file}:{enum.startLine} - enum {enum.name}? (y/n): ")
             if answer not in "yY":
                 continue
         header += f"//\n// {enum.name}\n//\n"
+        if Enum.constexpr:
+            header += enum.get_def_struct()
         header += enum.get_dec_toString()
         header += enum.get_dec_fromString() + "\n"
 
-        source += f"//\n// {enum.name}\n//\n"
-        source += enum.get_def_struct()
-        source += enum.get_def_toString()
-        source += enum.get_def_fromString()
+        if not Enum.constexpr:
+            source += f"//\n// {enum.name}\n//\n"
+            source += enum.get_def_struct()
+            source += enum.get_def_toString()
+            source += enum.get_def_fromString()
     header += "\n" + comment_gen_end
-    source += "\n" + comment_gen_end
+    if not Enum.constexpr:
+        source += "\n" + comment_gen_end
 
 
     with open(header_file, "w") as file:
         file.write(header)
-    with open(source_file, "w") as file:
-        file.write(source)
+    if source is not None:
+        with open(source_file, "w") as file:
+            file.write(source)
 
 
 
@@ -425,10 +502,12 @@ Synposis:           get_enum_str.py <Options>... <file>...
 --no-throw          return empty string/last enum value if the argument for to/fromString is invalid.
                     This would normaly throw gz::InvalidArgument
                     This option does not make the functions noexcept!
+--constexpr         define the functions as constexpr in the header instead of the source file,
+                    so that they can be used in constant expressions
 
 If the generated code produces errors:
 - check that necessary headers are included in the source file:
-  - gz-util/string.hpp
+  - gz-util/string/conversion.hpp
   - gz-util/exceptions.hpp (unless you use --no-throw)
 - check the namespaces of the enumerations, the generated code should be in global namespace
   nested namespace are not supported, you will have to correct that if you use them
@@ -459,6 +538,8 @@ if __name__ == "__main__":
             Enum.docstring_include_names = False
         elif argv[i] == "--docs-no-gen":
             Enum.docstring_include_generated = False
+        elif argv[i] == "--constexpr":
+            Enum.constexpr = True
         else:
             input_files.append(argv[i])
         i += 1
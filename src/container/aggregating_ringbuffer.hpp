@@ -0,0 +1,282 @@
+#pragma once
+
+#include "../exceptions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <deque>
+#include <limits>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace gz::util {
+    /**
+     * @brief A histogram with logarithmic buckets that estimates quantiles of a multiset of numbers
+     * @details
+     *  Values are sorted into buckets whose bounds grow by the factor gamma = (1 + accuracy) / (1 - accuracy).
+     *  A quantile estimate is then within a relative error of accuracy of the true value.
+     *  Unlike most streaming sketches, values can also be removed again, which makes it usable for sliding windows.
+     *
+     *  Inserting and removing are O(log b) and quantile() is O(b), where b is the number of non-empty buckets.
+     *  b does not depend on the number of values, only on their range and the accuracy
+     *  (eg. accuracy 0.01 needs about 1000 buckets to cover 1ns to 1000s).
+     */
+    class QuantileSketch {
+        public:
+            /**
+             * @param accuracy Relative accuracy of the estimates, must be in (0, 1)
+             * @throws InvalidArgument if accuracy is not in (0, 1)
+             */
+            QuantileSketch(double accuracy=0.01) {
+                if (!(accuracy > 0 and accuracy < 1)) {
+                    throw InvalidArgument("accuracy must be in (0, 1), but is " + std::to_string(accuracy), "QuantileSketch");
+                }
+                gamma = (1 + accuracy) / (1 - accuracy);
+                logGamma = std::log(gamma);
+                // the bucket of the largest double, infinite values are counted in it
+                maxBucket = std::min(std::ceil(std::log(std::numeric_limits<double>::max()) / logGamma) + 1,
+                                     static_cast<double>(std::numeric_limits<int>::max() - 1));
+            }
+
+            /// NaN is ignored, infinite values are counted in the largest bucket
+            void insert(double x) {
+                if (std::isnan(x)) { return; }
+                if (std::abs(x) < MIN_VALUE) { zeroCount++; }
+                else if (x > 0) { positive[getBucket(x)]++; }
+                else { negative[getBucket(-x)]++; }
+                count++;
+            }
+            /// @warning x must have been inserted before
+            void erase(double x) {
+                if (std::isnan(x)) { return; }
+                if (std::abs(x) < MIN_VALUE) { zeroCount--; }
+                else if (x > 0) { decrement(positive, getBucket(x)); }
+                else { decrement(negative, getBucket(-x)); }
+                count--;
+            }
+            void clear() {
+                positive.clear();
+                negative.clear();
+                zeroCount = 0;
+                count = 0;
+            }
+            size_t size() const { return count; }
+
+            /**
+             * @brief Estimate the q-quantile
+             * @param q in [0, 1], 0.5 is the median
+             * @returns The estimate or 0 if the sketch is empty
+             */
+            double quantile(double q) const {
+                if (count == 0) { return 0; }
+                size_t rank = static_cast<size_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(count - 1));
+                // negative values, from the most negative to the least negative
+                for (auto it = negative.rbegin(); it != negative.rend(); it++) {
+                    if (rank < it->second) { return -getValue(it->first); }
+                    rank -= it->second;
+                }
+                if (rank < zeroCount) { return 0; }
+                rank -= zeroCount;
+                for (auto it = positive.begin(); it != positive.end(); it++) {
+                    if (rank < it->second) { return getValue(it->first); }
+                    rank -= it->second;
+                }
+                return getValue(positive.rbegin()->first);
+            }
+
+        private:
+            /// Values with a smaller magnitude are counted as 0
+            static constexpr double MIN_VALUE = 1e-12;
+            /// @param x Positive, not NaN
+            int getBucket(double x) const { return static_cast<int>(std::clamp(std::ceil(std::log(x) / logGamma), -maxBucket, maxBucket)); }
+            /// Value in the middle of bucket i, in the sense of relative error
+            double getValue(int i) const { return std::pow(gamma, i) * (2 / (gamma + 1)); }
+            static void decrement(std::map<int, size_t>& buckets, int i) {
+                auto it = buckets.find(i);
+                if (it != buckets.end() and --it->second == 0) { buckets.erase(it); }
+            }
+            double gamma;
+            double logGamma;
+            /// Bucket indices are clamped to [-maxBucket, maxBucket], so that infinite values and tiny accuracies can not overflow the int
+            double maxBucket;
+            std::map<int, size_t> positive;
+            std::map<int, size_t> negative;  ///< Buckets for the magnitude of negative values
+            size_t zeroCount = 0;
+            size_t count = 0;
+    };
+} // namespace gz::util
+
+namespace gz {
+    /**
+     * @brief A ringbuffer holding a sliding window of numbers that maintains aggregates of the window
+     * @details
+     *  Like RingBuffer, a buffer with capacity n stores the n newest elements that were inserted.
+     *  Additionally, these aggregates are updated with every push_back():
+     *  - the sum and the sum of squares, for sum(), mean(), variance() and stddev()
+     *  - monotonic deques for min() and max()
+     *  - optionally a @ref util::QuantileSketch "quantile sketch" for quantile(), if the buffer was created with a quantileAccuracy
+     *
+     *  All queries except quantile() are O(1). push_back() is amortized O(1) (O(log b) with the quantile sketch, see util::QuantileSketch).
+     *  @code
+     *      AggregatingRingBuffer<double> latencies(1000, 0.01);
+     *      latencies.push_back(0.25);
+     *      ...
+     *      std::cout << latencies.mean() << " " << latencies.max() << " " << latencies.quantile(0.99);
+     *  @endcode
+     *
+     *  For floating point types, the sums are recalculated from the window after every capacity() insertions,
+     *  so that rounding errors do not accumulate.
+     */
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    class AggregatingRingBuffer {
+        public:
+            /**
+             * @param capacity The size of the window
+             * @param quantileAccuracy If > 0, maintain a quantile sketch with this relative accuracy
+             */
+            AggregatingRingBuffer(size_t capacity=10, double quantileAccuracy=0);
+
+            /**
+             * @brief Insert an element and update the aggregates, removing the oldest element if the window is full
+             */
+            void push_back(T t);
+            /**
+             * @brief Remove all elements
+             */
+            void clear();
+
+            /// @returns The newest element, undefined if the buffer is empty
+            T newest() const { return buffer[getIndex(writeCount - 1)]; }
+            /// @returns The oldest element, undefined if the buffer is empty
+            T oldest() const { return buffer[getIndex(writeCount - size())]; }
+
+            long double sum() const { return valueSum; }
+            /// @returns The arithmetic mean, 0 if empty
+            long double mean() const { return empty() ? 0 : valueSum / size(); }
+            /// @returns The population variance, 0 if empty
+            long double variance() const;
+            /// @returns The population standard deviation, 0 if empty
+            long double stddev() const { return std::sqrt(variance()); }
+            /// @returns The smallest element in the window, T() if empty
+            T min() const { return minDeque.empty() ? T() : minDeque.front().second; }
+            /// @returns The largest element in the window, T() if empty
+            T max() const { return maxDeque.empty() ? T() : maxDeque.front().second; }
+            /**
+             * @brief Estimate the q-quantile of the window
+             * @param q in [0, 1], 0.5 is the median
+             * @throws InvalidArgument if the buffer was created without quantileAccuracy
+             */
+            double quantile(double q) const;
+
+            size_t size() const { return std::min(writeCount, buffer.size()); }
+            size_t capacity() const { return buffer.size(); }
+            bool empty() const { return writeCount == 0; }
+
+        private:
+            size_t getIndex(size_t i) const { return i % buffer.size(); }
+            void recalculateSums();
+            std::vector<T> buffer;
+            /// Number of elements that were inserted since the last clear()
+            size_t writeCount;
+            long double valueSum;
+            long double squareSum;
+            /// (insertion number, value), values are increasing from front to back
+            std::deque<std::pair<size_t, T>> minDeque;
+            /// (insertion number, value), values are decreasing from front to back
+            std::deque<std::pair<size_t, T>> maxDeque;
+            std::optional<util::QuantileSketch> sketch;
+    };
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    AggregatingRingBuffer<T>::AggregatingRingBuffer(size_t capacity, double quantileAccuracy)
+        : buffer(std::max(capacity, static_cast<size_t>(1))), writeCount(0), valueSum(0), squareSum(0) {
+        if (quantileAccuracy > 0) {
+            sketch.emplace(quantileAccuracy);
+        }
+    }
+
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    void AggregatingRingBuffer<T>::push_back(T t) {
+        T& slot = buffer[getIndex(writeCount)];
+        if (writeCount >= buffer.size()) {  // remove the oldest element
+            valueSum -= slot;
+            squareSum -= static_cast<long double>(slot) * slot;
+            if (sketch) { sketch->erase(static_cast<double>(slot)); }
+        }
+        slot = t;
+        valueSum += t;
+        squareSum += static_cast<long double>(t) * t;
+        if (sketch) { sketch->insert(static_cast<double>(t)); }
+
+        // drop elements that are not in the window anymore, then those that can never be the min/max again
+        size_t oldest = writeCount + 1 > buffer.size() ? writeCount + 1 - buffer.size() : 0;
+        if (!minDeque.empty() and minDeque.front().first < oldest) { minDeque.pop_front(); }
+        if (!maxDeque.empty() and maxDeque.front().first < oldest) { maxDeque.pop_front(); }
+        while (!minDeque.empty() and minDeque.back().second >= t) { minDeque.pop_back(); }
+        while (!maxDeque.empty() and maxDeque.back().second <= t) { maxDeque.pop_back(); }
+        minDeque.emplace_back(writeCount, t);
+        maxDeque.emplace_back(writeCount, t);
+
+        writeCount++;
+        if constexpr (std::floating_point<T>) {
+            if (writeCount % buffer.size() == 0) { recalculateSums(); }
+        }
+    }
+
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    void AggregatingRingBuffer<T>::clear() {
+        writeCount = 0;
+        valueSum = 0;
+        squareSum = 0;
+        minDeque.clear();
+        maxDeque.clear();
+        if (sketch) { sketch->clear(); }
+    }
+
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    long double AggregatingRingBuffer<T>::variance() const {
+        if (empty()) { return 0; }
+        long double m = mean();
+        // rounding can make this slightly negative
+        return std::max(squareSum / size() - m * m, static_cast<long double>(0));
+    }
+
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    double AggregatingRingBuffer<T>::quantile(double q) const {
+        if (!sketch) {
+            throw InvalidArgument("AggregatingRingBuffer was created without quantileAccuracy", "AggregatingRingBuffer::quantile");
+        }
+        return sketch->quantile(q);
+    }
+
+
+    template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+    void AggregatingRingBuffer<T>::recalculateSums() {
+        valueSum = 0;
+        squareSum = 0;
+        for (size_t i = writeCount - size(); i < writeCount; i++) {
+            T t = buffer[getIndex(i)];
+            valueSum += t;
+            squareSum += static_cast<long double>(t) * t;
+        }
+    }
+} // namespace gz
+
+/**
+ * @file
+ * @brief Contains a ringbuffer that maintains sliding window aggregates like mean, min, max and quantiles
+ */
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace gz {
+    /**
+     * @brief A fixed size ringbuffer for a single producer and a single (or more) consumer thread(s), without locks
+     * @details
+     *  Like RingBuffer, a buffer with capacity n stores the n newest elements that were inserted.
+     *  One thread may push_back() elements, while other threads take @ref snapshot() "snapshots" of the newest elements.
+     *
+     *  Writing an element costs a copy into the buffer plus two counter stores and a release fence.
+     *  The producer never waits for the consumers.
+     *
+     * @subsection concurrent_ringbuffer_snapshot Snapshots
+     *  A snapshot copies the newest elements into a buffer provided by the caller, in the style of a seqlock:
+     *  The consumer reads the write counter, copies the elements and then reads the counter of started writes.
+     *  If the producer has started overwriting any of the copied elements in the meantime, the copy might be torn and trySnapshot() returns false.
+     *  snapshot() simply retries until it gets a consistent copy.
+     *  @code
+     *      ConcurrentRingBuffer<double> rb(1024);
+     *      // producer thread
+     *      rb.push_back(sample);
+     *      // consumer thread
+     *      std::array<double, 100> newest;
+     *      size_t n = rb.snapshot(newest);
+     *  @endcode
+     *
+     * @note
+     *  T must be trivially copyable, since a consumer might read an element while it is being overwritten (the result is then discarded).
+     *  There must be only one thread calling push_back().
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class ConcurrentRingBuffer {
+        public:
+            ConcurrentRingBuffer(size_t capacity=10);
+
+            /**
+             * @brief Insert an element, overwriting the oldest element if the buffer is full
+             * @warning Must only be called from a single thread
+             */
+            void push_back(const T& t);
+
+            /**
+             * @brief Try to copy the newest elements into out
+             * @details
+             *  Copies min(out.size(), size()) elements, ordered from oldest to newest, to the beginning of out.
+             * @param count Set to the number of copied elements
+             * @returns false if the producer overwrote elements during the copy. The contents of out are invalid then.
+             */
+            bool trySnapshot(std::span<T> out, size_t& count) const;
+            /**
+             * @brief Copy the newest elements into out, retry until the copy is consistent
+             * @returns The number of copied elements, min(out.size(), size())
+             */
+            size_t snapshot(std::span<T> out) const;
+
+            /// The number of elements that were ever inserted
+            size_t getWriteCount() const { return writeCount.load(std::memory_order_acquire); }
+            size_t size() const { return std::min(getWriteCount(), bufferCapacity); }
+            size_t capacity() const { return bufferCapacity; }
+
+        private:
+            size_t bufferCapacity;
+            std::unique_ptr<T[]> buffer;
+            /// Number of elements that were ever inserted, the newest element is at (writeCount - 1) % capacity. On its own cache line to prevent false sharing
+            alignas(64) std::atomic<size_t> writeCount;
+            /// Number of elements whose write has started, writeCount + 1 while push_back() copies an element
+            std::atomic<size_t> writeBeginCount;
+            /// Only used by the producer
+            alignas(64) size_t writeIndex;
+    };
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    ConcurrentRingBuffer<T>::ConcurrentRingBuffer(size_t capacity)
+        : bufferCapacity(std::max(capacity, static_cast<size_t>(1))), buffer(new T[bufferCapacity]), writeCount(0), writeBeginCount(0), writeIndex(0) {}
+
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void ConcurrentRingBuffer<T>::push_back(const T& t) {
+        const size_t count = writeCount.load(std::memory_order_relaxed) + 1;
+        // announce the write before overwriting the oldest element:
+        // a consumer that reads any byte of the new element will also see this store after its acquire fence
+        writeBeginCount.store(count, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&buffer[writeIndex], &t, sizeof(T));
+        if (++writeIndex == bufferCapacity) { writeIndex = 0; }
+        // publish the element
+        writeCount.store(count, std::memory_order_release);
+    }
+
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool ConcurrentRingBuffer<T>::trySnapshot(std::span<T> out, size_t& count) const {
+        const size_t end = writeCount.load(std::memory_order_acquire);
+        count = std::min({ out.size(), end, bufferCapacity });
+        const size_t begin = end - count;
+        // copy [begin, end), which might wrap around the end of the buffer
+        size_t beginIndex = begin % bufferCapacity;
+        size_t firstCount = std::min(count, bufferCapacity - beginIndex);
+        std::memcpy(out.data(), &buffer[beginIndex], firstCount * sizeof(T));
+        std::memcpy(out.data() + firstCount, &buffer[0], (count - firstCount) * sizeof(T));
+        // make sure the copy happens before the second load
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // writing element i (which sets writeBeginCount to i + 1) overwrites element i - capacity.
+        // the copy is valid if no write of an element >= begin + capacity has started
+        const size_t after = writeBeginCount.load(std::memory_order_relaxed);
+        return after <= begin + bufferCapacity;
+    }
+
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    size_t ConcurrentRingBuffer<T>::snapshot(std::span<T> out) const {
+        size_t count;
+        while (!trySnapshot(out, count)) {}
+        return count;
+    }
+} // namespace gz
+
+/**
+ * @file
+ * @brief Contains a lock-free ringbuffer for one producer and multiple consumers
+ */
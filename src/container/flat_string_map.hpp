@@ -0,0 +1,531 @@
+#pragma once
+
+#include "../exceptions.hpp"
+#include "../string/utility.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace gz::util {
+    /// Satisfied when T can be used as key for a flat_string_map
+    template<typename T>
+    concept StringViewConvertible = std::convertible_to<T, std::string_view>;
+
+    /**
+     * @brief A hash map with std::string keys that stores its elements in a flat array
+     * @details
+     *  An open addressing hash map in the style of a "swiss table":
+     *  Next to the slots for the elements, there is an array of control bytes, one per slot.
+     *  A control byte is either empty, deleted or holds 7 bits of the hash of the key in the slot.
+     *  A lookup compares 16 control bytes at a time with SSE2 (or in a loop on other architectures),
+     *  and only compares the keys of the slots where those 7 bits match.
+     *  Since the elements are not stored in individual nodes, a lookup usually touches only two cache lines.
+     *
+     *  All lookup functions, including at() and operator[], take a std::string_view,
+     *  so they work with std::string, std::string_view and const char* without constructing a std::string.
+     *  @code
+     *   gz::util::flat_string_map<int> map = { { "one", 1 }, { "two", 2 } };
+     *   std::string_view sv = "two";
+     *   map[sv] += 1;
+     *   int three = map.at(sv);
+     *  @endcode
+     *
+     * @note
+     *  Unlike std::unordered_map, inserting elements invalidates all iterators, pointers and references to elements
+     *  when the map grows. Erasing an element only invalidates iterators, pointers and references to that element.
+     * @note
+     *  The elements are moved when the map grows, if the move constructor of T throws the map is left in an unspecified state.
+     */
+    template<typename T>
+    class flat_string_map {
+        private:
+            /// Storage for an element that is only constructed when the slot is full
+            union Slot {
+                Slot() {}
+                ~Slot() {}
+                std::pair<const std::string, T> value;
+                /// Same layout as value, used to move the key when the map grows
+                std::pair<std::string, T> mutableValue;
+            };
+        public:
+            using key_type = std::string;
+            using mapped_type = T;
+            using value_type = std::pair<const std::string, T>;
+            using size_type = size_t;
+            using hasher = string_hash;
+
+            /**
+             * @brief Forward iterator over all elements, in no particular order
+             */
+            template<bool Const>
+            class Iterator {
+                public:
+                    using Map = std::conditional_t<Const, const flat_string_map, flat_string_map>;
+                    using value_type = flat_string_map::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using reference = std::conditional_t<Const, const value_type&, value_type&>;
+                    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+                    using iterator_category = std::forward_iterator_tag;
+
+                    Iterator() : map(nullptr), i(0) {}
+                    /// Convert iterator to const_iterator
+                    template<bool OtherConst>
+                        requires (Const and !OtherConst)
+                    Iterator(const Iterator<OtherConst>& other) : map(other.map), i(other.i) {}
+                    reference operator*() const { return map->slots[i].value; }
+                    pointer operator->() const { return &map->slots[i].value; }
+                    Iterator& operator++() { i = map->nextFull(i + 1); return *this; }
+                    Iterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+                    bool operator==(const Iterator& other) const { return i == other.i; }
+                private:
+                    friend flat_string_map;
+                    friend Iterator<!Const>;
+                    Iterator(Map* map, size_t i) : map(map), i(i) {}
+                    Map* map;
+                    size_t i;
+            };
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            flat_string_map() = default;
+            flat_string_map(std::initializer_list<value_type> init);
+            flat_string_map(const flat_string_map& other);
+            flat_string_map(flat_string_map&& other) noexcept { swap(other); }
+            flat_string_map& operator=(const flat_string_map& other);
+            flat_string_map& operator=(flat_string_map&& other) noexcept;
+            ~flat_string_map();
+
+        /**
+         * @name Lookup
+         * @{
+         */
+            iterator find(std::string_view key) { return iterator(this, findIndex(key)); }
+            const_iterator find(std::string_view key) const { return const_iterator(this, findIndex(key)); }
+            bool contains(std::string_view key) const { return findIndex(key) != capacity_; }
+            size_t count(std::string_view key) const { return contains(key) ? 1 : 0; }
+            /**
+             * @throws InvalidArgument if key is not in the map
+             */
+            T& at(std::string_view key);
+            const T& at(std::string_view key) const;
+            /**
+             * @brief Get the value for key, and insert a default constructed value if key is not in the map
+             */
+            template<StringViewConvertible K>
+            T& operator[](K&& key) { return try_emplace(std::forward<K>(key)).first->second; }
+        /// @}
+
+        /**
+         * @name Modifiers
+         * @details
+         *  The key is only converted to std::string when a new element is inserted.
+         *  If key is a std::string rvalue, it is moved into the map.
+         * @{
+         */
+            /**
+             * @brief Insert an element constructed from args, if key is not in the map
+             * @returns Iterator to the element with key, and whether it was inserted
+             */
+            template<StringViewConvertible K, typename... Args>
+                requires std::constructible_from<T, Args...>
+            std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+            /**
+             * @brief Insert value or assign it to the existing element with key
+             * @returns Iterator to the element with key, and whether it was inserted
+             */
+            template<StringViewConvertible K, typename M>
+                requires std::assignable_from<T&, M>
+            std::pair<iterator, bool> insert_or_assign(K&& key, M&& value);
+            std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+            std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(value.first, std::move(value.second)); }
+
+            /**
+             * @returns The number of erased elements (0 or 1)
+             */
+            size_t erase(std::string_view key);
+            /**
+             * @returns Iterator to the element after it
+             */
+            iterator erase(const_iterator it);
+            iterator erase(iterator it) { return erase(const_iterator(it)); }
+            /**
+             * @brief Destroy all elements, but keep the allocated memory
+             */
+            void clear();
+            void swap(flat_string_map& other) noexcept;
+        /// @}
+
+        /**
+         * @name Capacity
+         * @{
+         */
+            size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            /// Number of slots, the map grows when more than 7/8 of them are used
+            size_t capacity() const { return capacity_; }
+            /// Make sure that count elements can be stored without growing
+            void reserve(size_t count);
+        /// @}
+
+            iterator begin() { return iterator(this, nextFull(0)); }
+            iterator end() { return iterator(this, capacity_); }
+            const_iterator begin() const { return const_iterator(this, nextFull(0)); }
+            const_iterator end() const { return const_iterator(this, capacity_); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+        private:
+            static constexpr int8_t CTRL_EMPTY = -128;
+            static constexpr int8_t CTRL_DELETED = -2;
+            static constexpr size_t GROUP_WIDTH = 16;
+            static constexpr size_t MIN_CAPACITY = 16;
+
+            /**
+             * @brief 16 consecutive control bytes
+             * @details The match functions return a bitmask with bit i set if byte i matches.
+             */
+            class Group {
+                public:
+                    explicit Group(const int8_t* ctrl);
+                    uint32_t match(int8_t h2) const;
+                    uint32_t matchEmpty() const { return match(CTRL_EMPTY); }
+                    uint32_t matchEmptyOrDeleted() const;
+                private:
+#ifdef __SSE2__
+                    __m128i ctrl;
+#else
+                    int8_t ctrl[GROUP_WIDTH];
+#endif
+            };
+
+            static size_t hash(std::string_view key) { return string_hash{}(key); }
+            static size_t h1(size_t hash) { return hash >> 7; }
+            static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+            static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+            /// @returns Index of the slot with key, or capacity_ if key is not in the map
+            size_t findIndex(std::string_view key) const;
+            /// @returns Index of the first empty or deleted slot in the probe sequence of hash
+            size_t findInsertIndex(size_t hash) const;
+            /// @returns Index of the first full slot at or after i, or capacity_
+            size_t nextFull(size_t i) const;
+            /// Set control byte i and its clone after the end
+            void setCtrl(size_t i, int8_t h);
+            /// Move all elements into new arrays with newCapacity slots
+            void rehash(size_t newCapacity);
+            void destroyAll();
+            void deallocate();
+
+            /// capacity_ + GROUP_WIDTH - 1 bytes, the last bytes are clones of the first, so that a group can start at any slot
+            int8_t* ctrl = nullptr;
+            Slot* slots = nullptr;
+            /// Power of 2, or 0 if nothing has been allocated
+            size_t capacity_ = 0;
+            size_t size_ = 0;
+            /// Number of empty slots that can be filled before the map must grow
+            size_t growthLeft = 0;
+    };
+
+
+// GROUP
+    template<typename T>
+    flat_string_map<T>::Group::Group(const int8_t* ctrl) {
+#ifdef __SSE2__
+        this->ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        std::memcpy(this->ctrl, ctrl, GROUP_WIDTH);
+#endif
+    }
+
+    template<typename T>
+    uint32_t flat_string_map<T>::Group::match(int8_t h2) const {
+#ifdef __SSE2__
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; i++) {
+            if (ctrl[i] == h2) { mask |= 1u << i; }
+        }
+        return mask;
+#endif
+    }
+
+    template<typename T>
+    uint32_t flat_string_map<T>::Group::matchEmptyOrDeleted() const {
+        // empty and deleted are the only negative values except -1, which is not used
+#ifdef __SSE2__
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; i++) {
+            if (ctrl[i] < -1) { mask |= 1u << i; }
+        }
+        return mask;
+#endif
+    }
+
+
+// CONSTRUCTORS
+    template<typename T>
+    flat_string_map<T>::flat_string_map(std::initializer_list<value_type> init) {
+        reserve(init.size());
+        for (const value_type& value : init) {
+            insert(value);
+        }
+    }
+
+    template<typename T>
+    flat_string_map<T>::flat_string_map(const flat_string_map& other) {
+        reserve(other.size());
+        for (const value_type& value : other) {
+            insert(value);
+        }
+    }
+
+    template<typename T>
+    flat_string_map<T>& flat_string_map<T>::operator=(const flat_string_map& other) {
+        if (this != &other) {
+            flat_string_map copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template<typename T>
+    flat_string_map<T>& flat_string_map<T>::operator=(flat_string_map&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            deallocate();
+            swap(other);
+        }
+        return *this;
+    }
+
+    template<typename T>
+    flat_string_map<T>::~flat_string_map() {
+        destroyAll();
+        deallocate();
+    }
+
+
+// LOOKUP
+    template<typename T>
+    size_t flat_string_map<T>::findIndex(std::string_view key) const {
+        if (size_ == 0) { return capacity_; }
+        const size_t h = hash(key);
+        const size_t mask = capacity_ - 1;
+        size_t pos = h1(h) & mask;
+        // triangular probing visits every group when the capacity is a power of 2
+        for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+            Group group(ctrl + pos);
+            for (uint32_t match = group.match(h2(h)); match != 0; match &= match - 1) {
+                size_t i = (pos + static_cast<size_t>(std::countr_zero(match))) & mask;
+                if (slots[i].value.first == key) { return i; }
+            }
+            if (group.matchEmpty() != 0) { return capacity_; }
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template<typename T>
+    size_t flat_string_map<T>::findInsertIndex(size_t hash) const {
+        const size_t mask = capacity_ - 1;
+        size_t pos = h1(hash) & mask;
+        for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+            uint32_t match = Group(ctrl + pos).matchEmptyOrDeleted();
+            if (match != 0) {
+                return (pos + static_cast<size_t>(std::countr_zero(match))) & mask;
+            }
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template<typename T>
+    size_t flat_string_map<T>::nextFull(size_t i) const {
+        while (i < capacity_ and ctrl[i] < 0) { i++; }
+        return i;
+    }
+
+    template<typename T>
+    T& flat_string_map<T>::at(std::string_view key) {
+        size_t i = findIndex(key);
+        if (i == capacity_) {
+            throw InvalidArgument("Invalid key: '" + std::string(key) + "'", "flat_string_map::at");
+        }
+        return slots[i].value.second;
+    }
+
+    template<typename T>
+    const T& flat_string_map<T>::at(std::string_view key) const {
+        size_t i = findIndex(key);
+        if (i == capacity_) {
+            throw InvalidArgument("Invalid key: '" + std::string(key) + "'", "flat_string_map::at");
+        }
+        return slots[i].value.second;
+    }
+
+
+// MODIFIERS
+    template<typename T>
+    template<StringViewConvertible K, typename... Args>
+        requires std::constructible_from<T, Args...>
+    std::pair<typename flat_string_map<T>::iterator, bool> flat_string_map<T>::try_emplace(K&& key, Args&&... args) {
+        const std::string_view keyView = key;
+        size_t i = findIndex(keyView);
+        if (i != capacity_) {
+            return { iterator(this, i), false };
+        }
+        const size_t h = hash(keyView);
+        if (capacity_ != 0) { i = findInsertIndex(h); }
+        // reusing a deleted slot does not use up an empty slot
+        if (capacity_ == 0 or (growthLeft == 0 and ctrl[i] == CTRL_EMPTY)) {
+            // grow if more than half of the slots are used, otherwise there are many deleted slots that can be reclaimed
+            rehash(size_ + 1 > maxLoad(capacity_) / 2 ? std::max(capacity_ * 2, MIN_CAPACITY) : capacity_);
+            i = findInsertIndex(h);
+        }
+        if constexpr (std::is_rvalue_reference_v<K&&> and std::same_as<std::remove_cvref_t<K>, std::string>) {
+            std::construct_at(&slots[i].value, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        else {
+            std::construct_at(&slots[i].value, std::piecewise_construct, std::forward_as_tuple(keyView), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        if (ctrl[i] == CTRL_EMPTY) { growthLeft--; }
+        setCtrl(i, h2(h));
+        size_++;
+        return { iterator(this, i), true };
+    }
+
+    template<typename T>
+    template<StringViewConvertible K, typename M>
+        requires std::assignable_from<T&, M>
+    std::pair<typename flat_string_map<T>::iterator, bool> flat_string_map<T>::insert_or_assign(K&& key, M&& value) {
+        size_t i = findIndex(key);
+        if (i != capacity_) {
+            slots[i].value.second = std::forward<M>(value);
+            return { iterator(this, i), false };
+        }
+        return try_emplace(std::forward<K>(key), std::forward<M>(value));
+    }
+
+    template<typename T>
+    size_t flat_string_map<T>::erase(std::string_view key) {
+        size_t i = findIndex(key);
+        if (i == capacity_) { return 0; }
+        erase(const_iterator(this, i));
+        return 1;
+    }
+
+    template<typename T>
+    typename flat_string_map<T>::iterator flat_string_map<T>::erase(const_iterator it) {
+        std::destroy_at(&slots[it.i].value);
+        // the slot might be in the middle of a probe sequence, so it can not become empty
+        setCtrl(it.i, CTRL_DELETED);
+        size_--;
+        return iterator(this, nextFull(it.i + 1));
+    }
+
+    template<typename T>
+    void flat_string_map<T>::clear() {
+        destroyAll();
+        if (capacity_ != 0) {
+            std::memset(ctrl, static_cast<unsigned char>(CTRL_EMPTY), capacity_ + GROUP_WIDTH - 1);
+        }
+        size_ = 0;
+        growthLeft = maxLoad(capacity_);
+    }
+
+    template<typename T>
+    void flat_string_map<T>::swap(flat_string_map& other) noexcept {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growthLeft, other.growthLeft);
+    }
+
+    template<typename T>
+    void flat_string_map<T>::reserve(size_t count) {
+        if (count <= maxLoad(capacity_)) { return; }
+        size_t newCapacity = std::max(std::bit_ceil(count + count / 7 + 1), MIN_CAPACITY);
+        while (maxLoad(newCapacity) < count) { newCapacity *= 2; }
+        rehash(newCapacity);
+    }
+
+
+// MEMORY
+    template<typename T>
+    void flat_string_map<T>::setCtrl(size_t i, int8_t h) {
+        ctrl[i] = h;
+        // capacity_ >= GROUP_WIDTH, so every slot has at most one clone
+        if (i < GROUP_WIDTH - 1) {
+            ctrl[capacity_ + i] = h;
+        }
+    }
+
+    template<typename T>
+    void flat_string_map<T>::rehash(size_t newCapacity) {
+        int8_t* oldCtrl = ctrl;
+        Slot* oldSlots = slots;
+        const size_t oldCapacity = capacity_;
+
+        std::unique_ptr<int8_t[]> newCtrl(new int8_t[newCapacity + GROUP_WIDTH - 1]);
+        slots = std::allocator<Slot>().allocate(newCapacity);
+        ctrl = newCtrl.release();
+        std::memset(ctrl, static_cast<unsigned char>(CTRL_EMPTY), newCapacity + GROUP_WIDTH - 1);
+        capacity_ = newCapacity;
+        growthLeft = maxLoad(newCapacity) - size_;
+
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] < 0) { continue; }
+            std::pair<std::string, T>& value = oldSlots[i].mutableValue;
+            const size_t h = hash(value.first);
+            size_t j = findInsertIndex(h);
+            std::construct_at(&slots[j].mutableValue, std::move(value));
+            std::destroy_at(&value);
+            setCtrl(j, h2(h));
+        }
+        if (oldCapacity != 0) {
+            delete[] oldCtrl;
+            std::allocator<Slot>().deallocate(oldSlots, oldCapacity);
+        }
+    }
+
+    template<typename T>
+    void flat_string_map<T>::destroyAll() {
+        for (size_t i = nextFull(0); i < capacity_; i = nextFull(i + 1)) {
+            std::destroy_at(&slots[i].value);
+        }
+    }
+
+    template<typename T>
+    void flat_string_map<T>::deallocate() {
+        if (capacity_ == 0) { return; }
+        delete[] ctrl;
+        std::allocator<Slot>().deallocate(slots, capacity_);
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growthLeft = 0;
+    }
+} // namespace gz::util
+
+/**
+ * @file
+ * @brief Contains a flat hash map with std::string keys
+ */
@@ -0,0 +1,98 @@
+#include "magic_ringbuffer.hpp"
+
+#include "../exceptions.hpp"
+
+#include <cerrno>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace gz::util {
+
+#ifdef __linux__
+    size_t DoubleMappedMemory::getPageSize() {
+        static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return pageSize;
+    }
+
+
+    DoubleMappedMemory::DoubleMappedMemory(size_t minSize, size_t granularity)
+        : memory(nullptr), memorySize(0) {
+        // size must be a multiple of the page size, so that the second mapping can start right after the first one
+        size_t step = std::lcm(getPageSize(), std::max(granularity, static_cast<size_t>(1)));
+        size_t size = std::max((minSize + step - 1) / step, static_cast<size_t>(1)) * step;
+
+        int fd = memfd_create("gz::MagicRingBuffer", MFD_CLOEXEC);
+        if (fd == -1) {
+            throw Exception("memfd_create failed: errno=" + std::to_string(errno), "DoubleMappedMemory");
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
+            close(fd);
+            throw Exception("ftruncate failed: errno=" + std::to_string(errno), "DoubleMappedMemory");
+        }
+        // reserve address space for both mappings
+        void* base = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            close(fd);
+            throw Exception("Could not reserve address space: errno=" + std::to_string(errno), "DoubleMappedMemory");
+        }
+        std::byte* first = static_cast<std::byte*>(base);
+        if (mmap(first, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED or
+            mmap(first + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            int error = errno;
+            munmap(base, 2 * size);
+            close(fd);
+            throw Exception("Could not map memory: errno=" + std::to_string(error), "DoubleMappedMemory");
+        }
+        // the mappings keep the memory alive
+        close(fd);
+        memory = first;
+        memorySize = size;
+    }
+
+
+    void DoubleMappedMemory::unmap() noexcept {
+        if (memory != nullptr) {
+            munmap(memory, 2 * memorySize);
+            memory = nullptr;
+            memorySize = 0;
+        }
+    }
+#else
+    size_t DoubleMappedMemory::getPageSize() {
+        return 4096;
+    }
+
+    DoubleMappedMemory::DoubleMappedMemory(size_t, size_t)
+        : memory(nullptr), memorySize(0) {
+        throw Exception("Double mapped memory is not supported on this platform", "DoubleMappedMemory");
+    }
+
+    void DoubleMappedMemory::unmap() noexcept {}
+#endif
+
+
+    DoubleMappedMemory::~DoubleMappedMemory() {
+        unmap();
+    }
+
+
+    DoubleMappedMemory::DoubleMappedMemory(DoubleMappedMemory&& other) noexcept
+        : memory(std::exchange(other.memory, nullptr)), memorySize(std::exchange(other.memorySize, 0)) {}
+
+
+    DoubleMappedMemory& DoubleMappedMemory::operator=(DoubleMappedMemory&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            memory = std::exchange(other.memory, nullptr);
+            memorySize = std::exchange(other.memorySize, 0);
+        }
+        return *this;
+    }
+
+} // namespace gz::util
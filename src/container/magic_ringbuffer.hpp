@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace gz::util {
+    /**
+     * @brief Memory that is mapped twice, back-to-back, into virtual memory
+     * @details
+     *  The memory region [data(), data() + size()) is mirrored at [data() + size(), data() + 2 * size()),
+     *  so writing to data()[i] also changes data()[i + size()].
+     *
+     *  The size is always a multiple of the page size.
+     *  Only available on linux, on other platforms the constructor throws.
+     */
+    class DoubleMappedMemory {
+        public:
+            /**
+             * @brief Map at least minSize bytes twice
+             * @param minSize Minimum size of the region
+             * @param granularity The size will be a multiple of granularity (and of the page size)
+             * @throws Exception if the memory could not be mapped
+             */
+            DoubleMappedMemory(size_t minSize, size_t granularity=1);
+            ~DoubleMappedMemory();
+            DoubleMappedMemory(const DoubleMappedMemory&) = delete;
+            DoubleMappedMemory& operator=(const DoubleMappedMemory&) = delete;
+            DoubleMappedMemory(DoubleMappedMemory&& other) noexcept;
+            DoubleMappedMemory& operator=(DoubleMappedMemory&& other) noexcept;
+
+            std::byte* data() const { return memory; }
+            /// Size of the (single) region in bytes
+            size_t size() const { return memorySize; }
+
+            /// Get the page size of the system
+            static size_t getPageSize();
+        private:
+            void unmap() noexcept;
+            std::byte* memory;
+            size_t memorySize;
+    };
+} // namespace gz::util
+
+namespace gz {
+    /**
+     * @brief A ringbuffer whose contents are always contiguous in memory
+     * @details
+     *  Like RingBuffer, a MagicRingBuffer with capacity n stores the n newest elements that were inserted.
+     *  It is meant for byte streams (or other trivially copyable types) that have to be passed to functions expecting a pointer and a size,
+     *  like memcpy, read(2) or write(2).
+     *
+     *  The storage is @ref util::DoubleMappedMemory "mapped twice" directly after each other,
+     *  so any window of up to capacity() elements starting anywhere in the buffer is a single pointer range.
+     *  There is no need to handle the wrap-around:
+     *  @code
+     *      MagicRingBuffer<char> rb(4096);
+     *      // read directly into the buffer
+     *      auto window = rb.writeWindow();
+     *      ssize_t n = ::read(fd, window.data(), window.size());
+     *      if (n > 0) { rb.commit(n); }
+     *      // write out everything
+     *      auto data = rb.data();
+     *      n = ::write(fd2, data.data(), data.size());
+     *      if (n > 0) { rb.consume(n); }
+     *  @endcode
+     *
+     *  The capacity is rounded up so that the storage size is a multiple of the page size.
+     *
+     * @note Only available on linux, the constructor throws on other platforms.
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class MagicRingBuffer {
+        public:
+            /**
+             * @brief Create a buffer that can store at least capacity elements
+             * @throws Exception if the memory could not be mapped
+             */
+            MagicRingBuffer(size_t capacity=1);
+
+            /**
+             * @brief Insert an element, overwriting the oldest element if the buffer is full
+             */
+            void push_back(const T& t);
+            /**
+             * @brief Insert multiple elements using a single memcpy, overwriting the oldest elements if the buffer is full
+             * @details
+             *  If data holds more than capacity() elements, only the newest capacity() elements are stored.
+             */
+            void append(std::span<const T> data);
+
+            /**
+             * @brief Get all elements from oldest to newest
+             * @note The span is invalidated by any operation that modifies the buffer.
+             */
+            std::span<const T> data() const { return std::span<const T>(buffer() + readIndex, elementCount); }
+            /**
+             * @brief Get the free space after the newest element
+             * @details
+             *  Write up to writeWindow().size() elements into the span and then call commit() to add them to the buffer.
+             */
+            std::span<T> writeWindow() { return std::span<T>(buffer() + readIndex + elementCount, bufferCapacity - elementCount); }
+            /**
+             * @brief Add n elements that were written into writeWindow()
+             * @details n is clamped to writeWindow().size()
+             */
+            void commit(size_t n);
+            /**
+             * @brief Remove the n oldest elements
+             * @details n is clamped to size()
+             */
+            void consume(size_t n);
+            /**
+             * @brief Remove all elements
+             */
+            void clear() { readIndex = 0; elementCount = 0; }
+
+            size_t capacity() const { return bufferCapacity; }
+            size_t size() const { return elementCount; }
+            bool empty() const { return elementCount == 0; }
+
+        private:
+            T* buffer() const { return reinterpret_cast<T*>(memory.data()); }
+            util::DoubleMappedMemory memory;
+            size_t bufferCapacity;
+            size_t readIndex;  ///< Points to the oldest element, always < bufferCapacity
+            size_t elementCount;
+    };
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    MagicRingBuffer<T>::MagicRingBuffer(size_t capacity)
+        : memory(std::max(capacity, static_cast<size_t>(1)) * sizeof(T), sizeof(T)), readIndex(0), elementCount(0) {
+        bufferCapacity = memory.size() / sizeof(T);
+    }
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void MagicRingBuffer<T>::push_back(const T& t) {
+        size_t i = readIndex + elementCount;
+        if (i >= bufferCapacity) { i -= bufferCapacity; }
+        buffer()[i] = t;
+        if (elementCount < bufferCapacity) { elementCount++; }
+        else if (++readIndex == bufferCapacity) { readIndex = 0; }
+    }
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void MagicRingBuffer<T>::append(std::span<const T> data) {
+        if (data.size() > bufferCapacity) {
+            data = data.last(bufferCapacity);
+        }
+        size_t writeIndex = readIndex + elementCount;
+        if (writeIndex >= bufferCapacity) { writeIndex -= bufferCapacity; }
+        // writeIndex < capacity and data.size() <= capacity, so the copy stays within the mirrored region
+        std::memcpy(buffer() + writeIndex, data.data(), data.size_bytes());
+        size_t newCount = std::min(elementCount + data.size(), bufferCapacity);
+        readIndex = (readIndex + elementCount + data.size() - newCount) % bufferCapacity;
+        elementCount = newCount;
+    }
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void MagicRingBuffer<T>::commit(size_t n) {
+        elementCount += std::min(n, bufferCapacity - elementCount);
+    }
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void MagicRingBuffer<T>::consume(size_t n) {
+        n = std::min(n, elementCount);
+        readIndex += n;
+        if (readIndex >= bufferCapacity) { readIndex -= bufferCapacity; }
+        elementCount -= n;
+    }
+} // namespace gz
+
+/**
+ * @file
+ * @brief Contains a ringbuffer that uses double mapped memory so that its contents are always contiguous
+ */
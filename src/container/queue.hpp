@@ -7,7 +7,11 @@
 #include <iterator>
 #include <algorithm>
 #include <concepts>
+#include <limits>
+#include <memory>
+#include <span>
 #include <thread>
+#include <type_traits>
 
 namespace gz {
 
@@ -66,9 +70,24 @@ namespace gz {
              */
             Queue(size_t size=10, size_t maxSize=-1);
 
-            void push_back(T& t);
-            void push_back(T&& t) { push_back(t); };
-            void emplace_back(T&& t);
+            void push_back(const T& t);
+            void push_back(T&& t);
+            /**
+             * @brief Construct an element in place
+             * @details
+             *  If the element is inserted into a slot that already holds an (already retrieved) element,
+             *  it is constructed in place of the old element if that can not throw, otherwise it is move assigned.
+             */
+            template<typename... Args>
+                requires std::constructible_from<T, Args...>
+            void emplace_back(Args&&... args);
+            /**
+             * @brief Insert multiple elements, from first to last
+             * @details
+             *  The queue is locked only once. Contiguous free slots are filled with a single copy,
+             *  which is a memcpy if T is trivially copyable.
+             */
+            void append(std::span<const T> data);
 
             /**
              * @brief Check if the contains has an element that can be retrieved by get()
@@ -95,12 +114,21 @@ namespace gz {
 
             std::vector<T>& getInternalBuffer() { return buffer; }
         private:
+            /**
+             * @brief Insert an element, without locking
+             */
+            template<typename... Args>
+            void insert(Args&&... args);
             /**
              * @brief Resize the queue (if possible)
              * @details
              *  After calling this, readIndex and writeIndex will be valid so that a push_back or emplace_back can be performed.
              */
             void resize();
+            /// One slot always holds the last read element, so maxSize elements need maxSize + 1 slots
+            static size_t getMaxCapacity(size_t maxSize) {
+                return maxSize == std::numeric_limits<size_t>::max() ? maxSize : maxSize + 1;
+            }
 
             size_t writeIndex;  ///< Points to the element that was last written
             size_t readIndex;  ///< Points to the element that was last read
@@ -112,64 +140,107 @@ namespace gz {
 
     template<std::swappable T>
     Queue<T>::Queue(size_t capacity, size_t maxSize)
-        : vectorCapacity(capacity), maxSize(maxSize) {
-        buffer.reserve(capacity);
+        : vectorCapacity(std::clamp(capacity, static_cast<size_t>(1), getMaxCapacity(maxSize))), maxSize(maxSize) {
+        buffer.reserve(vectorCapacity);
         /* buffer.resize(2); */
 
-        writeIndex = capacity - 1;
-        readIndex = capacity - 1;
+        writeIndex = vectorCapacity - 1;
+        readIndex = vectorCapacity - 1;
     }
 
 
     template<std::swappable T>
     void Queue<T>::resize() {
+        const size_t maxCapacity = getMaxCapacity(maxSize);
         // if vector is at maxSize, "loose" the oldest element
-        if (buffer.size() == maxSize) {
-            incrementIndex(readIndex, buffer.size());
+        if (vectorCapacity >= maxCapacity) {
+            incrementIndex(readIndex, vectorCapacity);
             return;
         }
-        // if not at end of vector rotate so that oldest element is first
-        if (writeIndex != vectorCapacity - 1) {
-            // if not at end, reserve more space and move elements
-            std::rotate(buffer.begin(), buffer.begin() + readIndex, buffer.end());
-            readIndex = 0;
-            writeIndex = vectorCapacity - 1;
-        } 
+        // the queue is full: the elements are in the vectorCapacity - 1 slots after readIndex.
+        // rotate so that the oldest element is first. If the vector is not filled yet, nothing has wrapped around
+        // and the elements are already at [0, vectorCapacity - 1)
+        const size_t count = vectorCapacity - 1;
+        if (buffer.size() == vectorCapacity) {
+            std::rotate(buffer.begin(), buffer.begin() + getIncrementedIndex(readIndex, vectorCapacity), buffer.end());
+        }
         // reserve 10% more space (at least space for 3 more elements).
-        buffer.reserve(std::min(std::max(static_cast<size_t>(1.1 * vectorCapacity), vectorCapacity + 3), maxSize));
-        vectorCapacity = buffer.capacity();
+        vectorCapacity = std::min(std::max(static_cast<size_t>(1.1 * vectorCapacity), vectorCapacity + 3), maxCapacity);
+        buffer.reserve(vectorCapacity);
+        readIndex = vectorCapacity - 1;
+        writeIndex = count == 0 ? vectorCapacity - 1 : count - 1;
     }
 
 
     template<std::swappable T>
-    void Queue<T>::push_back(T& t) {
-        mtx.lock();
+    template<typename... Args>
+    void Queue<T>::insert(Args&&... args) {
         // check if this would write into oldest element
         if (readIndex == getIncrementedIndex(writeIndex, vectorCapacity)) { resize(); }
 
         util::incrementIndex(writeIndex, vectorCapacity);
-        if (buffer.size() < vectorCapacity) {
-            buffer.push_back(t); 
+        // writeIndex can wrap around before the vector is at its capacity
+        if (writeIndex >= buffer.size()) {
+            buffer.emplace_back(std::forward<Args>(args)...); 
+        }
+        else if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            std::destroy_at(&buffer[writeIndex]);
+            std::construct_at(&buffer[writeIndex], std::forward<Args>(args)...);
         }
         else {
-            buffer[writeIndex] = t;
+            buffer[writeIndex] = T(std::forward<Args>(args)...);
         }
+    }
+
+
+    template<std::swappable T>
+    void Queue<T>::push_back(const T& t) {
+        mtx.lock();
+        insert(t);
         mtx.unlock();
         /* std::cout << "queue after pushback. ri: " << readIndex << " - wi: " << writeIndex << " - size: " << buffer.size() << " - cap: " << vectorCapacity << "\n"; */
     }
 
 
     template<std::swappable T>
-    void Queue<T>::emplace_back(T&& t) {
+    void Queue<T>::push_back(T&& t) {
         mtx.lock();
-        if (readIndex == getIncrementedIndex(writeIndex, vectorCapacity)) { resize(); }
+        insert(std::move(t));
+        mtx.unlock();
+    }
 
-        util::incrementIndex(writeIndex, vectorCapacity);
-        if (buffer.size() < vectorCapacity) {
-            buffer.emplace_back(std::move(t)); 
-        }
-        else {
-            buffer[writeIndex] = std::move(t);
+
+    template<std::swappable T>
+    template<typename... Args>
+        requires std::constructible_from<T, Args...>
+    void Queue<T>::emplace_back(Args&&... args) {
+        mtx.lock();
+        insert(std::forward<Args>(args)...);
+        mtx.unlock();
+    }
+
+
+    template<std::swappable T>
+    void Queue<T>::append(std::span<const T> data) {
+        mtx.lock();
+        while (!data.empty()) {
+            if (readIndex == getIncrementedIndex(writeIndex, vectorCapacity)) { resize(); }
+            size_t begin = getIncrementedIndex(writeIndex, vectorCapacity);
+            // free slots reach until the last read element or the end of the vector
+            size_t end = readIndex >= begin ? readIndex : vectorCapacity;
+            size_t n = std::min(end - begin, data.size());
+            if (n == 0) {
+                // the queue can not hold any element
+                insert(data.front());
+                data = data.subspan(1);
+                continue;
+            }
+            // overwrite existing elements, then grow the vector
+            size_t overwriteCount = begin < buffer.size() ? std::min(n, buffer.size() - begin) : 0;
+            util::copyElements(data.data(), overwriteCount, buffer.data() + begin);
+            buffer.insert(buffer.end(), data.begin() + overwriteCount, data.begin() + n);
+            writeIndex = begin + n - 1;
+            data = data.subspan(n);
         }
         mtx.unlock();
     }
@@ -208,8 +279,8 @@ namespace gz {
     template<std::swappable T>
     void Queue<T>::clear() {
         mtx.lock();     
-        writeIndex = 0;
-        readIndex = 0;
+        // keep writeIndex, the next element must be written to the same slot as before
+        readIndex = writeIndex;
         mtx.unlock();
     }
 } // namespace gz
@@ -3,10 +3,13 @@
 /* #include "log.hpp" */
 #include "../util.hpp"
 
+#include <array>
 #include <vector>
 #include <iterator>
 #include <algorithm>
 #include <concepts>
+#include <memory>
+#include <span>
 
 namespace gz {
     /**
@@ -29,6 +32,19 @@ namespace gz {
      *
      *  If the buffer is empty, all iterators point to the separator element (end() == rend() == begin() == rbegin()).
      *
+     * @subsection ringbuffer_contiguous Contiguous access
+     *  The elements are stored in a std::vector, so they can also be accessed as contiguous memory:
+     *  - as_spans() returns (at most) two std::spans which together hold all elements from oldest to newest
+     *  - linearize() rotates the underlying vector so that all elements are in a single std::span
+     *  @code
+     *      RingBuffer<int> rb(4);
+     *      for (int i = 0; i < 7; i++) { rb.push_back(i); }
+     *      for (const auto& span : rb.as_spans()) {
+     *          for (int i : span) { std::cout << i << " "; }
+     *      }
+     *  @endcode
+     *  will produce @code 3 4 5 6 @endcode
+     *
      * @subsection ringbuffer_technical_details Technical Details
      *  A buffer with size n will store its objects in a std::vector with size n+1, where the additional element serves as a separator between the newest and the oldest element. 
      *  It is technically the real oldest element and could be accessed using end() or rend(), which will always point to this element (meaning end() == rend()), giving you a n+1 sized buffer.
@@ -125,9 +141,24 @@ namespace gz {
                     T* ptr;
                     const RingBuffer<T>& b;
             };
-            void push_back(T& t);
-            void push_back(T&& t) { push_back(t); };
-            void emplace_back(T&& t);
+            void push_back(const T& t);
+            void push_back(T&& t);
+            /**
+             * @brief Construct an element in place
+             * @details
+             *  While the buffer is growing, the element is constructed directly in the vector.
+             *  When it is full, the element is constructed in place of the separator if that can not throw, otherwise it is move assigned.
+             */
+            template<typename... Args>
+                requires std::constructible_from<T, Args...>
+            void emplace_back(Args&&... args);
+            /**
+             * @brief Insert multiple elements, from first to last
+             * @details
+             *  If data holds more than capacity() elements, only the last capacity() elements are stored.
+             *  If T is trivially copyable, this uses at most two memcpy calls once the buffer has reached its capacity.
+             */
+            void append(std::span<const T> data);
 
             /**
              * @brief Return an iterator pointing to the newest object
@@ -159,6 +190,26 @@ namespace gz {
              */
             void resize(const size_t size);
 
+            /**
+             * @brief Get the elements as (at most) two contiguous spans
+             * @details
+             *  The elements in the first span are followed by the elements in the second span, ordered from oldest to newest.
+             *  If the elements are already contiguous, the second span is empty.
+             *  If the buffer is empty, both spans are empty.
+             * @note The spans are invalidated by any operation that modifies the buffer.
+             */
+            std::array<std::span<const T>, 2> as_spans() const;
+
+            /**
+             * @brief Rotate the buffer so that all elements are contiguous
+             * @details
+             *  After calling this, the separator is the first element of the underlying vector and as_spans() will return an empty second span.
+             *  This requires moving all elements, so prefer as_spans() if you can handle two spans.
+             * @returns Span holding all elements from oldest to newest
+             * @note The span is invalidated by any operation that modifies the buffer.
+             */
+            std::span<const T> linearize();
+
             size_t capacity() const { return vectorCapacity - 1; }
             size_t size() const { return buffer.size() - 1; }
 
@@ -200,7 +251,29 @@ namespace gz {
     }
 
     template<std::swappable T>
-    void RingBuffer<T>::push_back(T& t) {
+    std::array<std::span<const T>, 2> RingBuffer<T>::as_spans() const {
+        if (buffer.size() <= 1) { return {}; }
+        // separator follows the newest element, the oldest element follows the separator
+        size_t oldestIndex = util::getIncrementedIndex(util::getIncrementedIndex(writeIndex, buffer.size()), buffer.size());
+        if (oldestIndex <= writeIndex) {
+            return { std::span<const T>(buffer.data() + oldestIndex, writeIndex + 1 - oldestIndex), std::span<const T>() };
+        }
+        return { std::span<const T>(buffer.data() + oldestIndex, buffer.size() - oldestIndex), std::span<const T>(buffer.data(), writeIndex + 1) };
+    }
+
+    template<std::swappable T>
+    std::span<const T> RingBuffer<T>::linearize() {
+        // separator becomes first element, same layout as while the vector is still growing
+        size_t separatorIndex = util::getIncrementedIndex(writeIndex, buffer.size());
+        if (separatorIndex != 0) {
+            std::rotate(buffer.begin(), buffer.begin() + separatorIndex, buffer.end());
+        }
+        writeIndex = buffer.size() - 1;
+        return std::span<const T>(buffer.data() + 1, buffer.size() - 1);
+    }
+
+    template<std::swappable T>
+    void RingBuffer<T>::push_back(const T& t) {
         util::incrementIndex(writeIndex, vectorCapacity);
         if (buffer.size() < vectorCapacity) {
             buffer.push_back(t); 
@@ -210,13 +283,52 @@ namespace gz {
         }
     }
     template<std::swappable T>
-    void RingBuffer<T>::emplace_back(T&& t) {
+    void RingBuffer<T>::push_back(T&& t) {
         util::incrementIndex(writeIndex, vectorCapacity);
         if (buffer.size() < vectorCapacity) {
-            buffer.emplace_back(std::move(t)); 
+            buffer.push_back(std::move(t)); 
         }
         else {
             buffer[writeIndex] = std::move(t);
         }
     }
+    template<std::swappable T>
+    template<typename... Args>
+        requires std::constructible_from<T, Args...>
+    void RingBuffer<T>::emplace_back(Args&&... args) {
+        util::incrementIndex(writeIndex, vectorCapacity);
+        if (buffer.size() < vectorCapacity) {
+            buffer.emplace_back(std::forward<Args>(args)...); 
+        }
+        else if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            std::destroy_at(&buffer[writeIndex]);
+            std::construct_at(&buffer[writeIndex], std::forward<Args>(args)...);
+        }
+        else {
+            buffer[writeIndex] = T(std::forward<Args>(args)...);
+        }
+    }
+
+    template<std::swappable T>
+    void RingBuffer<T>::append(std::span<const T> data) {
+        if (vectorCapacity <= 1) { return; }
+        // older elements would be overwritten anyway
+        if (data.size() > vectorCapacity - 1) {
+            data = data.last(vectorCapacity - 1);
+        }
+        // while growing, writeIndex is always the last element of the vector
+        if (buffer.size() < vectorCapacity) {
+            size_t n = std::min(vectorCapacity - buffer.size(), data.size());
+            buffer.insert(buffer.end(), data.begin(), data.begin() + n);
+            writeIndex = buffer.size() - 1;
+            data = data.subspan(n);
+        }
+        if (data.empty()) { return; }
+        // buffer is full: copy to the elements after writeIndex, then wrap around
+        size_t begin = util::getIncrementedIndex(writeIndex, vectorCapacity);
+        size_t firstCount = std::min(data.size(), vectorCapacity - begin);
+        util::copyElements(data.data(), firstCount, buffer.data() + begin);
+        util::copyElements(data.data() + firstCount, data.size() - firstCount, buffer.data());
+        writeIndex = (begin + data.size() - 1) % vectorCapacity;
+    }
 }
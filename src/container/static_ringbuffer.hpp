@@ -0,0 +1,184 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace gz {
+    /**
+     * @brief A ringbuffer with a compile-time capacity and inline storage
+     * @details
+     *  Like RingBuffer, a buffer with capacity N stores the N newest elements that were inserted.
+     *  Unlike RingBuffer, it does not allocate any memory: the elements are stored inside the object.
+     *  Elements are only constructed when they are inserted, so T does not need to be default constructible,
+     *  and emplace_back() constructs the element in place.
+     *
+     *  Since N is a template parameter, the index calculations can be optimized by the compiler (eg. to a bitwise and if N is a power of two).
+     *  All member functions are constexpr, so the buffer can also be used in constant expressions.
+     *
+     * @subsection static_ringbuffer_iteration Iteration
+     *  Same as RingBuffer, the iterators go from the newest to the oldest element, and operator[](0) is the newest element.
+     *  @code
+     *      StaticRingBuffer<int, 4> rb;
+     *      for (int i = 0; i < 7; i++) { rb.push_back(i); }
+     *      for (int i : rb) { std::cout << i << " "; }
+     *  @endcode
+     *  will produce @code 6 5 4 3 @endcode
+     */
+    template<typename T, size_t N>
+        requires (N > 0)
+    class StaticRingBuffer {
+        private:
+            /// Storage for a single element that is not constructed by default
+            union Slot {
+                constexpr Slot() {}
+                constexpr ~Slot() requires std::is_trivially_destructible_v<T> = default;
+                constexpr ~Slot() {}
+                T value;
+            };
+        public:
+            /**
+             * @brief Bidirectional iterator from the newest to the oldest element
+             */
+            template<bool Const>
+            struct Iterator {
+                public:
+                    using Buffer = std::conditional_t<Const, const StaticRingBuffer, StaticRingBuffer>;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using reference = std::conditional_t<Const, const T&, T&>;
+
+                    constexpr Iterator() : b(nullptr), i(0) {}
+                    constexpr Iterator(Buffer* b, size_t i) : b(b), i(i) {}
+                    constexpr reference operator*() const { return (*b)[i]; }
+                    constexpr auto operator->() const { return &(*b)[i]; }
+                    constexpr Iterator& operator++() { i++; return *this; }
+                    constexpr Iterator operator++(int) { auto copy = *this; i++; return copy; }
+                    constexpr Iterator& operator--() { i--; return *this; }
+                    constexpr Iterator operator--(int) { auto copy = *this; i--; return copy; }
+                    constexpr bool operator==(const Iterator& other) const { return i == other.i; }
+                private:
+                    Buffer* b;
+                    /// 0 is the newest element
+                    size_t i;
+            };
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            constexpr StaticRingBuffer() : head(0), count(0) {}
+            constexpr StaticRingBuffer(const StaticRingBuffer& other) : head(0), count(0) { copyFrom(other); }
+            constexpr StaticRingBuffer(StaticRingBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : head(0), count(0) { moveFrom(other); }
+            constexpr StaticRingBuffer& operator=(const StaticRingBuffer& other) {
+                if (this != &other) { clear(); copyFrom(other); }
+                return *this;
+            }
+            constexpr StaticRingBuffer& operator=(StaticRingBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+                if (this != &other) { clear(); moveFrom(other); }
+                return *this;
+            }
+            constexpr ~StaticRingBuffer() requires std::is_trivially_destructible_v<T> = default;
+            constexpr ~StaticRingBuffer() { clear(); }
+
+            /**
+             * @brief Construct an element in place, overwriting the oldest element if the buffer is full
+             * @details
+             *  If the buffer is full, the element is constructed first and then moved into the slot of the oldest element.
+             *  If that move constructor throws, the oldest element is lost.
+             * @returns Reference to the new element
+             */
+            template<typename... Args>
+                requires std::constructible_from<T, Args...>
+            constexpr T& emplace_back(Args&&... args);
+            constexpr void push_back(const T& t) { emplace_back(t); }
+            constexpr void push_back(T&& t) { emplace_back(std::move(t)); }
+
+            /**
+             * @brief Destroy all elements
+             */
+            constexpr void clear() {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = 0; i < count; i++) {
+                        std::destroy_at(&slots[getIndex(head + i)].value);
+                    }
+                }
+                head = 0;
+                count = 0;
+            }
+
+            /**
+             * @brief Access the i-th newest element
+             * @details operator[](0) is the newest element, operator[](size() - 1) the oldest. i must be < size().
+             */
+            constexpr T& operator[](size_t i) { return slots[getIndex(head + count - 1 - i)].value; }
+            constexpr const T& operator[](size_t i) const { return slots[getIndex(head + count - 1 - i)].value; }
+            /// @warning Undefined behavior if the buffer is empty
+            constexpr T& newest() { return (*this)[0]; }
+            constexpr const T& newest() const { return (*this)[0]; }
+            /// @warning Undefined behavior if the buffer is empty
+            constexpr T& oldest() { return slots[head].value; }
+            constexpr const T& oldest() const { return slots[head].value; }
+
+            /// Return an iterator pointing to the newest element
+            constexpr iterator begin() { return iterator(this, 0); }
+            /// Return an iterator pointing behind the oldest element
+            constexpr iterator end() { return iterator(this, count); }
+            constexpr const_iterator begin() const { return const_iterator(this, 0); }
+            constexpr const_iterator end() const { return const_iterator(this, count); }
+            constexpr const_iterator cbegin() const { return const_iterator(this, 0); }
+            constexpr const_iterator cend() const { return const_iterator(this, count); }
+
+            static constexpr size_t capacity() { return N; }
+            constexpr size_t size() const { return count; }
+            constexpr bool empty() const { return count == 0; }
+            constexpr bool full() const { return count == N; }
+
+        private:
+            static constexpr size_t getIndex(size_t i) { return i % N; }
+            constexpr void copyFrom(const StaticRingBuffer& other) {
+                for (size_t i = other.count; i > 0; i--) { emplace_back(other[i - 1]); }
+            }
+            constexpr void moveFrom(StaticRingBuffer& other) {
+                for (size_t i = other.count; i > 0; i--) { emplace_back(std::move(other[i - 1])); }
+                other.clear();
+            }
+            Slot slots[N];
+            size_t head;  ///< Index of the oldest element
+            size_t count;
+    };
+
+    template<typename T, size_t N>
+        requires (N > 0)
+    template<typename... Args>
+        requires std::constructible_from<T, Args...>
+    constexpr T& StaticRingBuffer<T, N>::emplace_back(Args&&... args) {
+        if (count < N) {
+            T* t = std::construct_at(&slots[getIndex(head + count)].value, std::forward<Args>(args)...);
+            count++;
+            return *t;
+        }
+        // overwrite the oldest element, which becomes the newest.
+        // construct the new element first, since args might reference the oldest element
+        T t(std::forward<Args>(args)...);
+        T* slot = &slots[head].value;
+        std::destroy_at(slot);
+        try {
+            std::construct_at(slot, std::move(t));
+        }
+        catch (...) {
+            // the destroyed slot is now empty
+            head = getIndex(head + 1);
+            count--;
+            throw;
+        }
+        head = getIndex(head + 1);
+        return *slot;
+    }
+} // namespace gz
+
+/**
+ * @file
+ * @brief Contains a ringbuffer with compile-time capacity that does not allocate memory
+ */
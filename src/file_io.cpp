@@ -3,10 +3,21 @@
 #include "exceptions.hpp"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <unordered_map>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace gz {
 
@@ -36,41 +47,65 @@ namespace gz {
     using mapSS = std::map<std::string, std::string>;
     using vecSS = std::vector<pairSS>;
 
-    inline void insert(vecSS& t, pairSS&& p) { t.emplace_back(p); }
-    inline void insert(umapSS& t, pairSS&& p) { t.emplace(p); }
-    inline void insert(mapSS& t, pairSS&& p) { t.emplace(p); }
+    inline void insert(vecSS& t, std::string&& key, std::string&& value) { t.emplace_back(std::move(key), std::move(value)); }
+    inline void insert(umapSS& t, std::string&& key, std::string&& value) { t.try_emplace(std::move(key), std::move(value)); }
+    inline void insert(mapSS& t, std::string&& key, std::string&& value) { t.try_emplace(std::move(key), std::move(value)); }
+
+namespace {
+    inline bool isSpace(char c) {
+        return c == ' ' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+    }
+
+    std::string_view trim(std::string_view s) {
+        while (!s.empty() and isSpace(s.front())) { s.remove_prefix(1); }
+        while (!s.empty() and isSpace(s.back())) { s.remove_suffix(1); }
+        return s;
+    }
+
+    std::string withoutSpaces(std::string_view s) {
+        std::string r;
+        r.reserve(s.size());
+        for (char c : s) {
+            if (!isSpace(c)) { r.push_back(c); }
+        }
+        return r;
+    }
+
+    /**
+     * @brief Call f(key, value) for every key-value pair in contents
+     * @details Every line is only scanned up to the line break, and the separator is searched within the line.
+     */
+    template<typename F>
+    void forEachKeyValuePair(std::string_view contents, F&& f) {
+        const char* p = contents.data();
+        const char* const end = p + contents.size();
+        while (p < end) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (lineEnd == nullptr) { lineEnd = end; }
+            const std::string_view line(p, static_cast<size_t>(lineEnd - p));
+            p = lineEnd + 1;
+
+            // ignore commented lines
+            if (line.starts_with('#')) { continue; }
+            const size_t eqPos = line.find('=');
+            if (eqPos == std::string_view::npos) { continue; }
+            f(trim(line.substr(0, eqPos)), trim(line.substr(eqPos + 1)));
+        }
+    }
+}
 
     template<ReadKeyValueFileImplemented T>
     T readKeyValueFile(const std::string& filepath, bool removeSpaces) {
         T attr;
-        std::string line;
-        int eqPos;
-        std::ifstream file(filepath);
-        if (file.is_open()) {
-            while (file.good()) {
-                getline(file, line);
-
-                // ignore commented lines
-                if (line.starts_with('#')) { continue; }
-
-                // if "=" in line: split into key - value pair and store in map
-                if (line.find("=") != std::string::npos) {
-                    if (removeSpaces) {  // remove all whitespaces
-                        line.erase(std::remove_if(line.begin(), line.end(), [](unsigned char x) { return std::isspace(x); }), line.end()); 
-                    }
-                    else {  // remove whitespaces until after equal sign
-                        eqPos = line.find("=");
-                        line.erase(std::remove_if(line.begin(), line.begin() + eqPos + 2, [](unsigned char x) { return std::isspace(x); }), line.begin() + eqPos + 2);
-                    }
-                    eqPos = line.find("=");
-                    insert(attr, std::pair{ line.substr(0, eqPos), line.substr(eqPos+1, line.length()) });
-                }
+        MappedFile file = mapFile(filepath, FM_SEQUENTIAL);
+        forEachKeyValuePair(file.view(), [&attr, removeSpaces](std::string_view key, std::string_view value) {
+            if (removeSpaces) {
+                insert(attr, withoutSpaces(key), withoutSpaces(value));
             }
-            file.close();
-        }
-        else {
-            throw FileIOError("Could not open file: '" + filepath + "'", "readKeyValueFile");
-        }
+            else {
+                insert(attr, std::string(key), std::string(value));
+            }
+        });
         return attr;
     }
     template umapSS readKeyValueFile<umapSS>(const std::string&, bool);
@@ -78,6 +113,15 @@ namespace gz {
     template vecSS readKeyValueFile<vecSS>(const std::string&, bool);
 
 
+    std::vector<std::pair<std::string_view, std::string_view>> parseKeyValueFile(std::string_view contents) {
+        std::vector<std::pair<std::string_view, std::string_view>> pairs;
+        forEachKeyValuePair(contents, [&pairs](std::string_view key, std::string_view value) {
+            pairs.emplace_back(key, value);
+        });
+        return pairs;
+    }
+
+
 
 //
 // BINARY-FILE
@@ -102,4 +146,98 @@ namespace gz {
     }
 
 
+//
+// MAPPED FILE
+//
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : contents(std::exchange(other.contents, {})), mapped(std::exchange(other.mapped, false)), buffer(std::move(other.buffer)) {}
+
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            // unmaps the current contents when going out of scope
+            MappedFile old(std::move(*this));
+            contents = std::exchange(other.contents, {});
+            mapped = std::exchange(other.mapped, false);
+            buffer = std::move(other.buffer);
+        }
+        return *this;
+    }
+
+
+    MappedFile::~MappedFile() {
+#ifdef __linux__
+        if (mapped) {
+            munmap(const_cast<std::byte*>(contents.data()), contents.size());
+        }
+#endif
+    }
+
+
+    MappedFile mapFile(const std::string& filepath, FileMapAdvice advice, bool hugePages) {
+        MappedFile file;
+#ifdef __linux__
+        int fd = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw FileIOError("Could not open file: '" + filepath + "': " + std::strerror(errno), "mapFile");
+        }
+        struct stat st;
+        // empty files can not be mapped, but files in /proc report a size of 0 and still have contents
+        if (fstat(fd, &st) == 0 and S_ISREG(st.st_mode) and st.st_size > 0) {
+            const size_t size = static_cast<size_t>(st.st_size);
+            void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                close(fd);
+                file.contents = std::span<const std::byte>(static_cast<const std::byte*>(data), size);
+                file.mapped = true;
+                switch (advice) {
+                    case FM_NORMAL:
+                        break;
+                    case FM_SEQUENTIAL:
+                        madvise(data, size, MADV_SEQUENTIAL);
+                        break;
+                    case FM_RANDOM:
+                        madvise(data, size, MADV_RANDOM);
+                        break;
+                    case FM_WILLNEED:
+                        madvise(data, size, MADV_WILLNEED);
+                        break;
+                }
+#ifdef MADV_HUGEPAGE
+                // only a hint, fails on filesystems without huge page support
+                if (hugePages) { madvise(data, size, MADV_HUGEPAGE); }
+#endif
+                return file;
+            }
+        }
+        // read into a buffer
+        std::byte chunk[1 << 16];
+        while (true) {
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n == -1 and errno == EINTR) { continue; }
+            if (n == -1) {
+                int error = errno;
+                close(fd);
+                throw FileIOError("Could not read file: '" + filepath + "': " + std::strerror(error), "mapFile");
+            }
+            if (n == 0) { break; }
+            file.buffer.insert(file.buffer.end(), chunk, chunk + n);
+        }
+        close(fd);
+#else
+        (void) advice;
+        (void) hugePages;
+        std::ifstream stream(filepath, std::ios::binary);
+        if (!stream.is_open()) {
+            throw FileIOError("Could not open file: '" + filepath + "'", "mapFile");
+        }
+        std::vector<char> chars{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+        file.buffer.resize(chars.size());
+        std::memcpy(file.buffer.data(), chars.data(), chars.size());
+#endif
+        file.contents = std::span<const std::byte>(file.buffer.data(), file.buffer.size());
+        return file;
+    }
+
+
 }
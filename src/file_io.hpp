@@ -2,7 +2,11 @@
 
 #include "string/utility.hpp"
 
+#include <cstddef>
 #include <map>
+#include <span>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -27,18 +31,101 @@ namespace gz {
 
     /**
      * @brief Read a file that contains key = value pairs
+     * @details
+     *  The file is mapped into memory and parsed in a single pass,
+     *  strings are only allocated when a pair is inserted into the container.
+     *  If a key occurs multiple times, the maps hold the first value.
+     * @param removeSpaces If true, all whitespaces in keys and values are removed, not only the surrounding ones
      * @throws FileIOError if the file can not be opened
      * @see @ref fio_t_key_value "Key-Value filetype"
      */
     template<ReadKeyValueFileImplemented T>
     [[nodiscard]] T readKeyValueFile(const std::string& filepath, bool removeSpaces=false);
 
+    /**
+     * @brief Parse the contents of a key-value file without copying them
+     * @details
+     *  The keys and values are string_views into contents, so contents must outlive the returned vector:
+     *  @code
+     *   gz::MappedFile file = gz::mapFile("settings.conf", gz::FM_SEQUENTIAL);
+     *   for (auto [key, value] : gz::parseKeyValueFile(file.view())) { ... }
+     *  @endcode
+     * @returns All pairs in the order of contents, including duplicate keys
+     * @see @ref fio_t_key_value "Key-Value filetype"
+     */
+    [[nodiscard]] std::vector<std::pair<std::string_view, std::string_view>> parseKeyValueFile(std::string_view contents);
+
 
     /**
      * @brief Read a binary file and return the 8-bit words in a vector
+     * @details To read large files without copying them, use mapFile()
      * @throws FileIOError if the file can not be opened
      */
     [[nodiscard]] std::vector<char> readBinaryFile(const std::string& filepath);
+
+
+    /**
+     * @brief How a MappedFile will be accessed
+     * @details
+     *  Passed to the kernel with madvise, so that it can read ahead or free pages early.
+     *  Has no effect if the file is not mapped.
+     */
+    enum FileMapAdvice {
+        /// No special treatment
+        FM_NORMAL,
+        /// The file is read from start to end, pages can be read ahead aggressively and freed after they were read
+        FM_SEQUENTIAL,
+        /// The file is read in random order, read ahead is not useful
+        FM_RANDOM,
+        /// The whole file will be needed soon, start reading it in the background
+        FM_WILLNEED,
+    };
+
+    /**
+     * @brief The read-only contents of a file, usually mapped into memory
+     * @details
+     *  Created by mapFile(). The mapping is removed when the MappedFile is destroyed,
+     *  so data() and view() must not be used afterwards.
+     */
+    class MappedFile {
+        public:
+            /// Empty file
+            MappedFile() = default;
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            ~MappedFile();
+
+            std::span<const std::byte> data() const { return contents; }
+            /// The contents as chars, for text files
+            std::string_view view() const { return std::string_view(reinterpret_cast<const char*>(contents.data()), contents.size()); }
+            size_t size() const { return contents.size(); }
+            bool empty() const { return contents.empty(); }
+            /// @returns false if the file could not be mapped and was read into a buffer instead
+            bool isMapped() const { return mapped; }
+
+        private:
+            friend MappedFile mapFile(const std::string& filepath, FileMapAdvice advice, bool hugePages);
+            std::span<const std::byte> contents;
+            bool mapped = false;
+            /// Holds the contents if the file is not mapped
+            std::vector<std::byte> buffer;
+    };
+
+    /**
+     * @brief Map a file read-only into memory
+     * @details
+     *  The pages of the file are only read when they are accessed, and they are not copied:
+     *  The memory is shared with the page cache, so mapping a large file does not allocate memory for its contents.
+     *
+     *  If the file can not be mapped (eg. pipes or files in /proc, or not on linux), it is read into a buffer instead.
+     * @param advice How the file will be accessed
+     * @param hugePages If true, ask the kernel to use transparent huge pages for the mapping.
+     *  This reduces TLB misses when accessing large files, but is only supported by some filesystems.
+     * @throws FileIOError if the file can not be opened or read
+     */
+    [[nodiscard]] MappedFile mapFile(const std::string& filepath, FileMapAdvice advice=FM_NORMAL, bool hugePages=false);
 }
 
 /**
@@ -49,9 +136,10 @@ namespace gz {
  * @page FileIO
  * @section fio_filetypes Filetypes
  *  @subsection fio_t_key_value Simple Key-Value file
- *   A file that contains key - value pairs in each line, separated with "=".
- *   Whitespaces around the separator are allowed.
+ *   A file that contains key - value pairs in each line, separated with the first "=".
+ *   Whitespaces around keys and values are removed, lines may end with "\n" or "\r\n".
  *   If the first character of a line is "#", the whole line is a comment.
+ *   Lines without "=" are ignored.
  *   Example:
  *   @code
  *    key1 = value1
@@ -306,14 +306,10 @@ class Log {
 
     private:
         // vlog for variadic log
-        /// Log anything that can be appendend to std::string
-        template<util::Stringy T, Logable... Args>
+        /// Log anything where toString exists, by appending it directly to the log line
+        template<Logable T, Logable... Args>
         void vlog(const char* appendChars, T&& t,  Args&&... args);
 
-        /// Log anything where toString exists
-        template<ConvertibleToString T, Logable... Args>
-        void vlog(const char* appendChars, T&& t,  Args&&... args) requires (!util::Stringy<T>);
-
         /// End for the recursion
         void vlog(const char* appendChars) {};
 
@@ -474,18 +470,10 @@ class Log {
     };
 
 
-    template<util::Stringy T, Logable... Args>
+    template<Logable T, Logable... Args>
     void Log::vlog(const char* appendChars, T&& t,  Args&&... args) {
         argsBegin().emplace_back(logLines()[iter()].size());
-        logLines()[iter()] += std::string(t);
-        logLines()[iter()] += appendChars;
-        vlog(" ", std::forward<Args>(args)...);
-    }
-    /// Log anything where toString exists
-    template<ConvertibleToString T, Logable... Args>
-    void Log::vlog(const char* appendChars, T&& t,  Args&&... args) requires (!util::Stringy<T>) {
-        argsBegin().emplace_back(logLines()[iter()].size());
-        logLines()[iter()] += toString(t);
+        _toStringAppendAny(logLines()[iter()], t);
         logLines()[iter()] += appendChars;
         vlog(" ", std::forward<Args>(args)...);
     }
@@ -1,7 +1,294 @@
 #include "regex.hpp"
 
+#include "file_io.hpp"
+#include "string/utility.hpp"
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 namespace gz::re {
     const std::regex types::intT(R"([+\-]?(0x|0X)?\d+)");
     const std::regex types::uintT(R"(\+?(0x|0X)?\d+)");
     const std::regex types::floatT(R"([+\-]?(((\d+\.?\d*)|(\d*\.?\d+))(e[+\-]?\d+)?)|(inf(inity)?)|(nan\w*)|((0x|0X)((\d+\.?\d*)|(\d*\.?\d+))(p[+\-]?\d+)?))", std::regex::icase);
+
+
+//
+// CACHE
+//
+namespace {
+    using Regex = std::shared_ptr<const std::regex>;
+    /// (flags, pattern), the pattern points to the key in the map
+    using LruList = std::list<std::pair<std::regex::flag_type, const std::string*>>;
+
+    struct CacheEntry {
+        /// Ready once the pattern is compiled
+        std::shared_future<Regex> regex;
+        /// The promise of the call that compiles the pattern, to identify the entry after compilation
+        const void* owner;
+        LruList::iterator lruPosition;
+    };
+
+    struct RegexCache {
+        std::mutex mtx;
+        /// One map of patterns for every combination of flags
+        std::unordered_map<std::regex::flag_type, util::unordered_string_map<CacheEntry>> patterns;
+        /// The most recently used entry is at the front
+        LruList lru;
+        size_t capacity = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+
+        void erase(util::unordered_string_map<CacheEntry>& map, util::unordered_string_map<CacheEntry>::iterator it) {
+            lru.erase(it->second.lruPosition);
+            map.erase(it);
+        }
+        void evict() {
+            while (capacity > 0 and lru.size() > capacity) {
+                auto [flags, pattern] = lru.back();
+                auto& map = patterns[flags];
+                erase(map, map.find(*pattern));
+            }
+        }
+    };
+
+    RegexCache& getCache() {
+        static RegexCache cache;
+        return cache;
+    }
+}
+
+
+std::shared_ptr<const std::regex> cached(std::string_view pattern, std::regex::flag_type flags) {
+    RegexCache& cache = getCache();
+    std::promise<Regex> promise;
+    std::unique_lock lock(cache.mtx);
+    auto& patterns = cache.patterns[flags];
+    auto it = patterns.find(pattern);
+    if (it != patterns.end()) {
+        cache.hits++;
+        cache.lru.splice(cache.lru.begin(), cache.lru, it->second.lruPosition);
+        std::shared_future<Regex> regex = it->second.regex;
+        // another thread might still be compiling the pattern
+        lock.unlock();
+        return regex.get();
+    }
+    cache.misses++;
+    it = patterns.emplace(std::string(pattern), CacheEntry{ promise.get_future().share(), &promise, {} }).first;
+    cache.lru.emplace_front(flags, &it->first);
+    it->second.lruPosition = cache.lru.begin();
+    cache.evict();
+    lock.unlock();
+
+    // compile without holding the lock
+    try {
+        Regex regex = std::make_shared<const std::regex>(pattern.begin(), pattern.end(), flags);
+        promise.set_value(regex);
+        return regex;
+    }
+    catch (...) {
+        promise.set_exception(std::current_exception());
+        // do not cache invalid patterns. the entry might have been evicted in the meantime
+        lock.lock();
+        // clearCache() might have removed the map
+        auto& map = cache.patterns[flags];
+        it = map.find(pattern);
+        if (it != map.end() and it->second.owner == &promise) {
+            cache.erase(map, it);
+        }
+        throw;
+    }
+}
+
+
+CacheStats getCacheStats() {
+    RegexCache& cache = getCache();
+    std::lock_guard lock(cache.mtx);
+    return CacheStats{ cache.hits, cache.misses, cache.lru.size(), cache.capacity };
 }
+
+
+void setCacheCapacity(size_t capacity) {
+    RegexCache& cache = getCache();
+    std::lock_guard lock(cache.mtx);
+    cache.capacity = capacity;
+    cache.evict();
+}
+
+
+void clearCache() {
+    RegexCache& cache = getCache();
+    std::lock_guard lock(cache.mtx);
+    cache.patterns.clear();
+    cache.lru.clear();
+    cache.hits = 0;
+    cache.misses = 0;
+}
+
+} // namespace gz::re
+
+
+//
+// STATIC REGEX
+//
+namespace gz::util {
+    void setRegexMatch(re::svmatch& m, std::string_view sv, std::optional<std::string_view> match) {
+        // match_results can only be filled by the std::regex algorithms, so let one of them find an empty match or none at all.
+        // This is O(1) since the regexes match (or fail) at the first position.
+        static const std::regex empty("");
+        static const std::regex none(R"([^\s\S])");
+        if (!match) {
+            std::regex_search(sv.end(), sv.end(), m, none);
+            return;
+        }
+        std::regex_search(sv.begin(), sv.end(), m, empty);
+        // now m[0] and the prefix are empty at the beginning of sv and the suffix is sv.
+        // They are not const objects, only the accessors are const, so they can be modified
+        auto begin = match->begin();
+        auto end = match->end();
+        auto& full = const_cast<re::svsub_match&>(m[0]);
+        full.first = begin;
+        full.second = end;
+        full.matched = true;
+        auto& prefix = const_cast<re::svsub_match&>(m.prefix());
+        prefix.second = begin;
+        prefix.matched = prefix.first != prefix.second;
+        auto& suffix = const_cast<re::svsub_match&>(m.suffix());
+        suffix.first = end;
+        suffix.matched = suffix.first != suffix.second;
+    }
+} // namespace gz::util
+
+
+//
+// SEARCH FILE
+//
+namespace gz::util {
+namespace {
+    /// Files smaller than this are not split into multiple chunks
+    constexpr size_t SEARCH_FILE_MIN_CHUNK_SIZE = 1 << 20;
+
+    /// Result of a chunk that is searched on another thread
+    struct ChunkResult {
+        /// Line numbers are relative to the chunk
+        std::vector<re::FileMatch> matches;
+        size_t lineCount = 0;
+        std::exception_ptr error;
+        /// Set when the chunk was searched
+        std::atomic<bool> done = false;
+    };
+
+    /**
+     * @brief Call emit with every match in chunk, line numbers are relative to the chunk
+     * @param offset Offset of chunk in the file
+     * @returns The number of lines in chunk
+     */
+    template<typename F>
+    size_t searchChunk(std::string_view chunk, size_t offset, const LineSearcher& search, F&& emit) {
+        size_t lineCount = 0;
+        size_t lineBegin = 0;
+        while (lineBegin < chunk.size()) {
+            size_t lineEnd = chunk.find('\n', lineBegin);
+            if (lineEnd == std::string_view::npos) { lineEnd = chunk.size(); }
+            std::string_view line = chunk.substr(lineBegin, lineEnd - lineBegin);
+            if (line.ends_with('\r')) { line.remove_suffix(1); }
+            lineCount++;
+
+            size_t begin = 0;
+            while (begin <= line.size()) {
+                std::optional<std::string_view> match = search(line, begin);
+                if (!match) { break; }
+                size_t matchBegin = static_cast<size_t>(match->data() - line.data());
+                emit(re::FileMatch{ *match, line, lineCount, offset + lineBegin + matchBegin });
+                // continue after the match, but do not find the same empty match again
+                begin = matchBegin + std::max(match->size(), static_cast<size_t>(1));
+            }
+            lineBegin = lineEnd + 1;
+        }
+        return lineCount;
+    }
+}
+
+
+    size_t searchFile(const std::string& filepath, const LineSearcher& search, const re::FileMatchCallback& callback, unsigned int threadCount) {
+        MappedFile file = mapFile(filepath, FM_SEQUENTIAL);
+        std::string_view contents = file.view();
+
+        if (threadCount == 0) {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        size_t chunkCount = std::max(std::min(static_cast<size_t>(threadCount), contents.size() / SEARCH_FILE_MIN_CHUNK_SIZE), static_cast<size_t>(1));
+        // split after line breaks
+        std::vector<size_t> boundaries = { 0 };
+        for (size_t i = 1; i < chunkCount; i++) {
+            size_t lineBreak = contents.find('\n', std::max(contents.size() / chunkCount * i, boundaries.back()));
+            if (lineBreak == std::string_view::npos) { break; }
+            boundaries.push_back(lineBreak + 1);
+        }
+        boundaries.push_back(contents.size());
+        auto getChunk = [&](size_t i) { return contents.substr(boundaries[i], boundaries[i + 1] - boundaries[i]); };
+
+        // results of the chunks after the first one, the first one is passed to the callback directly
+        std::vector<ChunkResult> results(boundaries.size() - 2);
+        auto searchChunkAt = [&](size_t i) {
+            ChunkResult& result = results[i - 1];
+            try {
+                result.lineCount = searchChunk(getChunk(i), boundaries[i], search, [&result](const re::FileMatch& match) {
+                    result.matches.push_back(match);
+                });
+            }
+            catch (...) {
+                result.error = std::current_exception();
+            }
+            result.done.store(true, std::memory_order_release);
+            result.done.notify_one();
+        };
+
+        // joins the threads when leaving the scope, also if the callback throws
+        std::vector<std::jthread> threads;
+        for (size_t i = 1; i < boundaries.size() - 1; i++) {
+            threads.emplace_back(searchChunkAt, i);
+        }
+
+        size_t matchCount = 0;
+        size_t lineOffset = searchChunk(getChunk(0), 0, search, [&](const re::FileMatch& match) {
+            callback(match);
+            matchCount++;
+        });
+        // pass the other chunks in order, each as soon as it is done
+        for (ChunkResult& result : results) {
+            result.done.wait(false, std::memory_order_acquire);
+            if (result.error) { std::rethrow_exception(result.error); }
+            for (re::FileMatch& match : result.matches) {
+                match.lineNumber += lineOffset;
+                callback(match);
+            }
+            matchCount += result.matches.size();
+            lineOffset += result.lineCount;
+            result.matches = {};
+        }
+        return matchCount;
+    }
+} // namespace gz::util
+
+
+namespace gz::re {
+
+
+size_t search_file(const std::string& filepath, const std::regex& pattern, const FileMatchCallback& callback, unsigned int threadCount) {
+    return util::searchFile(filepath, [&pattern](std::string_view line, size_t begin) -> std::optional<std::string_view> {
+        svmatch match;
+        auto flags = begin > 0 ? std::regex_constants::match_prev_avail : std::regex_constants::match_default;
+        if (!std::regex_search(line.begin() + static_cast<std::ptrdiff_t>(begin), line.end(), match, pattern, flags)) {
+            return std::nullopt;
+        }
+        return get_sv(match[0]);
+    }, callback, threadCount);
+}
+
+} // namespace gz::re
@@ -1,9 +1,487 @@
 #pragma once
 
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <regex>
+#include <string>
 #include <string_view>
 
 namespace gz::re {
+    /**
+     * @brief A string that can be used as template parameter, for static_regex
+     */
+    template<size_t N>
+    struct fixed_string {
+        constexpr fixed_string(const char (&s)[N]) { std::copy_n(s, N, data); }
+        constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+        char data[N];
+    };
+}
+
+
+namespace gz::util {
+    /// Set of chars, for a position in a static_regex
+    struct RegexCharSet {
+        std::array<uint64_t, 4> words{};
+        constexpr void set(unsigned char c) { words[c / 64] |= uint64_t(1) << (c % 64); }
+        constexpr bool test(unsigned char c) const { return words[c / 64] & (uint64_t(1) << (c % 64)); }
+        constexpr void setRange(unsigned char first, unsigned char last) { for (unsigned c = first; c <= last; c++) { set(static_cast<unsigned char>(c)); } }
+        constexpr RegexCharSet& operator|=(const RegexCharSet& other) { for (size_t i = 0; i < 4; i++) { words[i] |= other.words[i]; } return *this; }
+        constexpr RegexCharSet inverted() const { RegexCharSet s; for (size_t i = 0; i < 4; i++) { s.words[i] = ~words[i]; } return s; }
+    };
+
+    /// Set of positions (states) of a static_regex
+    template<size_t W>
+    struct RegexPositions {
+        std::array<uint64_t, W> words{};
+        constexpr void set(size_t i) { words[i / 64] |= uint64_t(1) << (i % 64); }
+        constexpr bool any() const { for (uint64_t w : words) { if (w != 0) { return true; } } return false; }
+        constexpr RegexPositions& operator|=(const RegexPositions& other) { for (size_t i = 0; i < W; i++) { words[i] |= other.words[i]; } return *this; }
+        constexpr RegexPositions operator&(const RegexPositions& other) const { RegexPositions r; for (size_t i = 0; i < W; i++) { r.words[i] = words[i] & other.words[i]; } return r; }
+        constexpr RegexPositions operator|(const RegexPositions& other) const { RegexPositions r = *this; r |= other; return r; }
+    };
+
+    /// Maximum number of positions (chars and char classes, after expanding {n,m}) in a static_regex
+    constexpr size_t REGEX_MAX_POSITIONS = 256;
+    using RegexParsePositions = RegexPositions<REGEX_MAX_POSITIONS / 64>;
+
+    /// Glushkov automaton of a pattern, while parsing
+    struct RegexParseResult {
+        size_t count = 0;
+        std::array<RegexCharSet, REGEX_MAX_POSITIONS> classes{};
+        std::array<RegexParsePositions, REGEX_MAX_POSITIONS> follow{};
+        RegexParsePositions first;
+        RegexParsePositions last;
+        bool nullable = false;
+        bool anchoredStart = false;
+        bool anchoredEnd = false;
+    };
+
+    /**
+     * @brief Parse a regular expression into a Glushkov automaton
+     * @details
+     *  Every char or char class of the pattern is a position. The automaton tracks the set of positions that matched the last char,
+     *  for every position it knows which positions may follow (follow), which may be the first (first) and which may be the last (last).
+     *  Repetitions with {n,m} are expanded, by parsing the repeated atom again.
+     */
+    class RegexParser {
+        public:
+            constexpr RegexParser(std::string_view pattern, bool icase) : p(pattern), i(0), icase(icase) {}
+
+            constexpr RegexParseResult parse() {
+                if (i < p.size() and p[i] == '^') { r.anchoredStart = true; i++; }
+                Expr e = parseAlternation();
+                if (i < p.size() and p[i] == '$' and i + 1 == p.size()) { r.anchoredEnd = true; i++; }
+                if (i != p.size()) { error("unexpected char"); }
+                r.first = e.first;
+                r.last = e.last;
+                r.nullable = e.nullable;
+                return r;
+            }
+
+        private:
+            struct Expr {
+                RegexParsePositions first;
+                RegexParsePositions last;
+                bool nullable = true;
+            };
+
+            constexpr void error(const char* what) const {
+                // throwing is not a constant expression, so this produces a compile error when parsing at compile time
+                if (what != nullptr) {
+                    throw InvalidArgument(std::string(what) + " at " + std::to_string(i) + " in '" + std::string(p) + "'", "static_regex");
+                }
+            }
+            constexpr bool atEnd() const { return i >= p.size(); }
+            constexpr char peek() const { return p[i]; }
+
+            constexpr Expr concat(const Expr& a, const Expr& b) {
+                for (size_t pos = 0; pos < r.count; pos++) {
+                    if (a.last.words[pos / 64] & (uint64_t(1) << (pos % 64))) { r.follow[pos] |= b.first; }
+                }
+                Expr e;
+                e.first = a.nullable ? a.first | b.first : a.first;
+                e.last = b.nullable ? a.last | b.last : b.last;
+                e.nullable = a.nullable and b.nullable;
+                return e;
+            }
+            /// Add the edges for repeating e
+            constexpr void loop(const Expr& e) {
+                for (size_t pos = 0; pos < r.count; pos++) {
+                    if (e.last.words[pos / 64] & (uint64_t(1) << (pos % 64))) { r.follow[pos] |= e.first; }
+                }
+            }
+
+            constexpr Expr parseAlternation() {
+                Expr e = parseConcat();
+                while (!atEnd() and peek() == '|') {
+                    i++;
+                    Expr other = parseConcat();
+                    e.first |= other.first;
+                    e.last |= other.last;
+                    e.nullable = e.nullable or other.nullable;
+                }
+                return e;
+            }
+
+            constexpr Expr parseConcat() {
+                Expr e;
+                while (!atEnd() and peek() != '|' and peek() != ')') {
+                    if (peek() == '$' and i + 1 == p.size()) { break; }
+                    e = concat(e, parseRepeat());
+                }
+                return e;
+            }
+
+            constexpr size_t parseNumber() {
+                if (atEnd() or peek() < '0' or peek() > '9') { error("expected a number"); }
+                size_t n = 0;
+                while (!atEnd() and peek() >= '0' and peek() <= '9') { n = n * 10 + static_cast<size_t>(peek() - '0'); i++; }
+                return n;
+            }
+
+            constexpr Expr parseRepeat() {
+                const size_t atomBegin = i;
+                Expr atom = parseAtom();
+                const size_t atomEnd = i;
+                while (!atEnd() and (peek() == '*' or peek() == '+' or peek() == '?' or peek() == '{')) {
+                    char q = peek();
+                    i++;
+                    if (q == '*') { loop(atom); atom.nullable = true; }
+                    else if (q == '+') { loop(atom); }
+                    else if (q == '?') { atom.nullable = true; }
+                    else {
+                        size_t min = parseNumber();
+                        size_t max = min;
+                        bool unbounded = false;
+                        if (!atEnd() and peek() == ',') {
+                            i++;
+                            if (!atEnd() and peek() == '}') { unbounded = true; }
+                            else { max = parseNumber(); }
+                        }
+                        if (atEnd() or peek() != '}') { error("expected '}'"); }
+                        i++;
+                        if (!unbounded and max < min) { error("invalid repetition"); }
+                        atom = repeat(atom, atomBegin, atomEnd, min, max, unbounded);
+                    }
+                    // lazy quantifiers match the same strings
+                    if (!atEnd() and peek() == '?' and q != '?') { i++; }
+                }
+                return atom;
+            }
+
+            /// Expand atom{min,max} by parsing the atom again for every copy
+            constexpr Expr repeat(const Expr& atom, size_t atomBegin, size_t atomEnd, size_t min, size_t max, bool unbounded) {
+                bool atomUsed = false;
+                auto copy = [&]() {
+                    if (!atomUsed) { atomUsed = true; return atom; }
+                    size_t end = i;
+                    i = atomBegin;
+                    Expr e = parseAtom();
+                    // the copy must consist of the same chars as the atom
+                    if (i != atomEnd) { error("invalid repetition"); }
+                    i = end;
+                    return e;
+                };
+                Expr e;
+                for (size_t n = 0; n < min; n++) { e = concat(e, copy()); }
+                if (unbounded) {
+                    Expr rest = copy();
+                    loop(rest);
+                    rest.nullable = true;
+                    e = concat(e, rest);
+                }
+                else {
+                    for (size_t n = min; n < max; n++) {
+                        Expr optional = copy();
+                        optional.nullable = true;
+                        e = concat(e, optional);
+                    }
+                }
+                return e;
+            }
+
+            /**
+             * @brief With icase, add the other case of every letter in chars
+             * @details Must happen before a set is negated, so that eg. `[^a]` matches neither `a` nor `A`.
+             */
+            constexpr void foldCase(RegexCharSet& chars) const {
+                if (!icase) { return; }
+                for (unsigned c = 'a'; c <= 'z'; c++) {
+                    unsigned char upper = static_cast<unsigned char>(c - 'a' + 'A');
+                    if (chars.test(static_cast<unsigned char>(c)) or chars.test(upper)) { chars.set(static_cast<unsigned char>(c)); chars.set(upper); }
+                }
+            }
+
+            constexpr Expr position(RegexCharSet chars) {
+                if (r.count == REGEX_MAX_POSITIONS) { error("pattern has too many positions"); }
+                foldCase(chars);
+                r.classes[r.count] = chars;
+                Expr e;
+                e.first.set(r.count);
+                e.last.set(r.count);
+                e.nullable = false;
+                r.count++;
+                return e;
+            }
+
+            constexpr Expr parseAtom() {
+                if (atEnd()) { error("expected an expression"); }
+                char c = peek();
+                i++;
+                RegexCharSet chars;
+                switch (c) {
+                    case '(': {
+                        if (!atEnd() and peek() == '?') {
+                            if (i + 1 < p.size() and p[i + 1] == ':') { i += 2; }
+                            else { error("lookarounds are not supported"); }
+                        }
+                        Expr e = parseAlternation();
+                        if (atEnd() or peek() != ')') { error("expected ')'"); }
+                        i++;
+                        return e;
+                    }
+                    case '[':
+                        return position(parseClass());
+                    case '.':
+                        chars.set('\n');
+                        chars.set('\r');
+                        return position(chars.inverted());
+                    case '\\':
+                        return position(parseEscape());
+                    case '*': case '+': case '?': case '{': case ')': case '|':
+                        error("unexpected char");
+                        break;
+                    case '^': case '$':
+                        error("anchors are only supported at the beginning and end of the pattern");
+                        break;
+                }
+                chars.set(static_cast<unsigned char>(c));
+                return position(chars);
+            }
+
+            /// Parse the escape sequence after a backslash
+            constexpr RegexCharSet parseEscape() {
+                if (atEnd()) { error("pattern ends with '\\'"); }
+                char c = peek();
+                i++;
+                RegexCharSet chars;
+                switch (c) {
+                    case 'd': case 'D':
+                        chars.setRange('0', '9');
+                        break;
+                    case 'w': case 'W':
+                        chars.setRange('0', '9');
+                        chars.setRange('a', 'z');
+                        chars.setRange('A', 'Z');
+                        chars.set('_');
+                        break;
+                    case 's': case 'S':
+                        for (char w : std::string_view(" \t\n\r\f\v")) { chars.set(static_cast<unsigned char>(w)); }
+                        break;
+                    case 't': chars.set('\t'); return chars;
+                    case 'n': chars.set('\n'); return chars;
+                    case 'r': chars.set('\r'); return chars;
+                    case 'f': chars.set('\f'); return chars;
+                    case 'v': chars.set('\v'); return chars;
+                    case '0': chars.set('\0'); return chars;
+                    case 'x': {
+                        unsigned value = 0;
+                        for (size_t n = 0; n < 2; n++) {
+                            if (atEnd()) { error("expected two hex digits"); }
+                            char h = peek();
+                            i++;
+                            if (h >= '0' and h <= '9') { value = value * 16 + static_cast<unsigned>(h - '0'); }
+                            else if ((h | 0x20) >= 'a' and (h | 0x20) <= 'f') { value = value * 16 + static_cast<unsigned>((h | 0x20) - 'a' + 10); }
+                            else { error("expected two hex digits"); }
+                        }
+                        chars.set(static_cast<unsigned char>(value));
+                        return chars;
+                    }
+                    default:
+                        if ((c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9')) {
+                            error("unsupported escape sequence");
+                        }
+                        chars.set(static_cast<unsigned char>(c));
+                        return chars;
+                }
+                // uppercase classes are the complement
+                if (c >= 'A' and c <= 'Z') {
+                    foldCase(chars);
+                    return chars.inverted();
+                }
+                return chars;
+            }
+
+            /// Parse a char class, after the '['
+            constexpr RegexCharSet parseClass() {
+                RegexCharSet chars;
+                bool negate = !atEnd() and peek() == '^';
+                if (negate) { i++; }
+                while (true) {
+                    if (atEnd()) { error("expected ']'"); }
+                    char c = peek();
+                    i++;
+                    if (c == ']') { break; }
+                    unsigned char first = static_cast<unsigned char>(c);
+                    if (c == '\\') {
+                        if (!atEnd() and (peek() == 'd' or peek() == 'D' or peek() == 'w' or peek() == 'W' or peek() == 's' or peek() == 'S')) {
+                            chars |= parseEscape();
+                            continue;
+                        }
+                        RegexCharSet escaped = parseEscape();
+                        for (unsigned e = 0; e < 256; e++) {
+                            if (escaped.test(static_cast<unsigned char>(e))) { first = static_cast<unsigned char>(e); }
+                        }
+                    }
+                    // range, unless the '-' is the last char
+                    if (i + 1 < p.size() and peek() == '-' and p[i + 1] != ']') {
+                        i++;
+                        char l = peek();
+                        i++;
+                        unsigned char last = static_cast<unsigned char>(l);
+                        if (l == '\\') {
+                            RegexCharSet escaped = parseEscape();
+                            for (unsigned e = 0; e < 256; e++) {
+                                if (escaped.test(static_cast<unsigned char>(e))) { last = static_cast<unsigned char>(e); }
+                            }
+                        }
+                        if (last < first) { error("invalid range"); }
+                        chars.setRange(first, last);
+                    }
+                    else {
+                        chars.set(first);
+                    }
+                }
+                if (negate) {
+                    foldCase(chars);
+                    return chars.inverted();
+                }
+                return chars;
+            }
+
+            std::string_view p;
+            size_t i;
+            bool icase;
+            RegexParseResult r;
+    };
+
+    /**
+     * @brief Automaton of a static_regex with W * 64 positions
+     */
+    template<size_t W>
+    struct RegexAutomaton {
+        /// For every char, the positions that match it
+        std::array<RegexPositions<W>, 256> charPositions{};
+        /// For every position, the positions that may follow it
+        std::array<RegexPositions<W>, W * 64> follow{};
+        RegexPositions<W> first;
+        RegexPositions<W> last;
+        bool nullable = false;
+        bool anchoredStart = false;
+        bool anchoredEnd = false;
+
+        /// The positions that are reached from states when reading c
+        constexpr RegexPositions<W> step(const RegexPositions<W>& states, unsigned char c) const {
+            RegexPositions<W> next;
+            for (size_t w = 0; w < W; w++) {
+                uint64_t bits = states.words[w];
+                while (bits != 0) {
+                    next |= follow[w * 64 + static_cast<size_t>(std::countr_zero(bits))];
+                    bits &= bits - 1;
+                }
+            }
+            return next & charPositions[c];
+        }
+    };
+
+    template<size_t W>
+    constexpr RegexAutomaton<W> makeRegexAutomaton(const RegexParseResult& r) {
+        auto convert = [](const RegexParsePositions& positions) {
+            RegexPositions<W> converted;
+            for (size_t w = 0; w < W; w++) { converted.words[w] = positions.words[w]; }
+            return converted;
+        };
+        RegexAutomaton<W> a;
+        for (size_t pos = 0; pos < r.count; pos++) {
+            a.follow[pos] = convert(r.follow[pos]);
+            for (unsigned c = 0; c < 256; c++) {
+                if (r.classes[pos].test(static_cast<unsigned char>(c))) { a.charPositions[c].set(pos); }
+            }
+        }
+        a.first = convert(r.first);
+        a.last = convert(r.last);
+        a.nullable = r.nullable;
+        a.anchoredStart = r.anchoredStart;
+        a.anchoredEnd = r.anchoredEnd;
+        return a;
+    }
+
+    template<re::fixed_string Pattern, std::regex::flag_type Flags>
+    inline constexpr RegexParseResult regexParseResult = RegexParser(Pattern.view(), (Flags & std::regex::icase) != std::regex::flag_type{}).parse();
+
+    template<re::fixed_string Pattern, std::regex::flag_type Flags>
+    inline constexpr auto regexAutomaton = makeRegexAutomaton<std::max((regexParseResult<Pattern, Flags>.count + 63) / 64, static_cast<size_t>(1))>(regexParseResult<Pattern, Flags>);
+} // namespace gz::util
+
+
+namespace gz::re {
+    /**
+     * @brief A regular expression that is compiled at compile time
+     * @details
+     *  The pattern is parsed into a Glushkov automaton at compile time, which is then simulated using bitsets:
+     *  Matching reads every char exactly once and needs no allocations, unlike the backtracking std::regex.
+     *  All functions are constexpr, so they can also be used in constant expressions.
+     *  @code
+     *   constexpr gz::re::static_regex<R"([+\-]?\d+)"> integer;
+     *   static_assert(integer.match("-42"));
+     *   if (gz::re::regex_search(line, integer)) { ... }
+     *   gz::re::svmatch m;
+     *   if (gz::re::regex_search(line, m, integer)) { std::cout << m.str(0); }
+     *  @endcode
+     *
+     *  Supported syntax (ECMAScript subset):
+     *  - chars, `.` (anything but `\n` and `\r`), escapes (`\d \w \s \D \W \S \t \n \r \f \v \0 \xhh` and escaped special chars)
+     *  - char classes like `[a-z_]`, `[^\d]`
+     *  - groups `(...)` and `(?:...)`, alternatives `|`
+     *  - quantifiers `* + ? {n} {n,} {n,m}` (lazy variants are accepted and match the same strings)
+     *  - `^` at the beginning and `$` at the end of the pattern
+     *
+     *  Groups do not capture, backreferences and lookarounds are not supported.
+     *  An invalid or unsupported pattern is a compile error.
+     *  The pattern may have at most 256 positions (chars or char classes, after expanding `{n,m}`).
+     *
+     * @tparam Flags Only std::regex::icase changes the behavior
+     */
+    template<fixed_string Pattern, std::regex::flag_type Flags=std::regex::ECMAScript>
+    struct static_regex {
+        /**
+         * @brief Check if the whole string matches the pattern
+         */
+        static constexpr bool match(std::string_view sv);
+        /**
+         * @brief Check if any substring matches the pattern
+         */
+        static constexpr bool search(std::string_view sv);
+        /**
+         * @brief Find the leftmost longest substring that matches the pattern
+         * @details
+         *  Unlike std::regex, which prefers the first alternative, the longest match at the leftmost position is returned.
+         * @returns The match, pointing into sv, or std::nullopt
+         */
+        static constexpr std::optional<std::string_view> find(std::string_view sv);
+
+        static constexpr std::string_view pattern() { return Pattern.view(); }
+    };
+
     struct types {
         /// convertible with std::stoi
         static const std::regex intT;
@@ -11,6 +489,13 @@ namespace gz::re {
         static const std::regex uintT;
         /// convertible with std::stof
         static const std::regex floatT;
+
+        /// same as intT, but compiled at compile time
+        using staticIntT = static_regex<R"([+\-]?(0x|0X)?\d+)">;
+        /// same as uintT, but compiled at compile time
+        using staticUintT = static_regex<R"(\+?(0x|0X)?\d+)">;
+        /// same as floatT, but compiled at compile time
+        using staticFloatT = static_regex<R"([+\-]?(((\d+\.?\d*)|(\d*\.?\d+))(e[+\-]?\d+)?)|(inf(inity)?)|(nan\w*)|((0x|0X)((\d+\.?\d*)|(\d*\.?\d+))(p[+\-]?\d+)?))", std::regex::icase>;
     };
 
 
@@ -39,11 +524,228 @@ namespace gz::re {
     inline bool regex_search(std::string_view sv, const std::regex& e, std::regex_constants::match_flag_type flags = std::regex_constants::match_default) {
         return std::regex_search(sv.begin(), sv.end(), e, flags);
     }
+
+    /// @overload
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    constexpr bool regex_match(std::string_view sv, const static_regex<Pattern, Flags>&) {
+        return static_regex<Pattern, Flags>::match(sv);
+    }
+    /// @overload
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    constexpr bool regex_search(std::string_view sv, const static_regex<Pattern, Flags>&) {
+        return static_regex<Pattern, Flags>::search(sv);
+    }
+    /**
+     * @overload
+     * @brief Match with a static_regex and store the match in m
+     * @details Groups do not capture, so m only holds the full match as m[0], and its prefix and suffix.
+     */
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    bool regex_match(std::string_view sv, svmatch& m, const static_regex<Pattern, Flags>&);
+    /**
+     * @overload
+     * @brief Search with a static_regex and store the match in m
+     * @details
+     *  Groups do not capture, so m only holds the full match as m[0], and its prefix and suffix.
+     *  The match is found with static_regex::find(), so it is the leftmost longest match.
+     */
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    bool regex_search(std::string_view sv, svmatch& m, const static_regex<Pattern, Flags>&);
+    /// @}
+
+
+    /**
+     * @name Process-wide cache of compiled regular expressions
+     * @details
+     *  Constructing a std::regex compiles the pattern, which is expensive.
+     *  cached() compiles every (pattern, flags) combination only once per process and returns the same regex to all callers:
+     *  @code
+     *   for (const auto& line : lines) {
+     *       if (gz::re::regex_search(line, *gz::re::cached(R"(\d+ms)"))) { ... }
+     *   }
+     *  @endcode
+     *  All functions are thread safe. If multiple threads request the same uncached pattern,
+     *  it is compiled by the first one while the others wait for the result.
+     *
+     *  The cache is unbounded by default. With setCacheCapacity(), the least recently used patterns are evicted when the cache is full.
+     *  Evicted regexes stay valid as long as a shared_ptr to them exists.
+     * @{
+     */
+        /**
+         * @brief Get the compiled regex for pattern, compiling it if it is not cached
+         * @details The lookup does not allocate if the pattern is cached.
+         * @throws std::regex_error if pattern is not a valid regular expression. Invalid patterns are not cached.
+         */
+        std::shared_ptr<const std::regex> cached(std::string_view pattern, std::regex::flag_type flags=std::regex::ECMAScript);
+
+        struct CacheStats {
+            /// Number of calls to cached() that found the pattern in the cache
+            size_t hits;
+            /// Number of calls to cached() that had to compile the pattern
+            size_t misses;
+            /// Number of cached regexes
+            size_t size;
+            /// Maximum number of cached regexes, 0 if unbounded
+            size_t capacity;
+        };
+        CacheStats getCacheStats();
+        /**
+         * @brief Set the maximum number of cached regexes, 0 for unbounded
+         * @details If the cache holds more than capacity regexes, the least recently used ones are evicted.
+         */
+        void setCacheCapacity(size_t capacity);
+        /**
+         * @brief Remove all regexes from the cache and reset the counters
+         */
+        void clearCache();
+    /// @}
+
+
+    /**
+     * @brief A match found by search_file()
+     * @details The string_views point into the mapped file and are only valid during the callback.
+     */
+    struct FileMatch {
+        /// The matched text
+        std::string_view match;
+        /// The line that contains the match, without the line break
+        std::string_view line;
+        /// Number of the line, starting at 1
+        size_t lineNumber;
+        /// Offset of the match in the file, in bytes
+        size_t offset;
+    };
+    using FileMatchCallback = std::function<void(const FileMatch&)>;
+} // namespace gz::re
+
+
+namespace gz::util {
+    /**
+     * @brief Make m hold match, a substring of sv, like a std::regex_search in sv that found it
+     * @details If match is std::nullopt, m is set to the result of an unsuccessful search.
+     */
+    void setRegexMatch(re::svmatch& m, std::string_view sv, std::optional<std::string_view> match);
+
+    /// Find the first match in line that starts at or after begin
+    using LineSearcher = std::function<std::optional<std::string_view>(std::string_view line, size_t begin)>;
+    /// Implementation of search_file() for any kind of regex
+    size_t searchFile(const std::string& filepath, const LineSearcher& search, const re::FileMatchCallback& callback, unsigned int threadCount);
+} // namespace gz::util
+
+
+namespace gz::re {
+    /**
+     * @name Searching files
+     * @details
+     *  Search all matches of a regex in a file, line by line like grep.
+     *  The file is mapped into memory and searched using std::string_view, so its contents are never copied.
+     *  Every match is passed to the callback, in the order of the file, on the calling thread.
+     *
+     *  Large files are split into chunks at line boundaries, which are searched in parallel.
+     *  Each thread gets at least 1 MiB of the file, so small files are searched on the calling thread.
+     *  The first chunk is searched on the calling thread, which passes its matches to the callback as soon as they are found.
+     *  The matches of every other chunk are buffered and passed once that chunk and all chunks before it are done.
+     *  @code
+     *   gz::re::search_file("app.log", std::regex(R"(ERROR: (.*))"), [](const gz::re::FileMatch& m) {
+     *       std::cout << m.lineNumber << ": " << m.line << "\n";
+     *   });
+     *  @endcode
+     * @param threadCount Maximum number of threads, 0 = std::thread::hardware_concurrency()
+     * @returns The number of matches
+     * @throws FileIOError if the file can not be opened
+     * @{
+     */
+        size_t search_file(const std::string& filepath, const std::regex& pattern, const FileMatchCallback& callback, unsigned int threadCount=0);
+        /**
+         * @overload
+         * @details Matches are found with static_regex::find(), so they are the leftmost longest matches.
+         */
+        template<fixed_string Pattern, std::regex::flag_type Flags>
+        size_t search_file(const std::string& filepath, const static_regex<Pattern, Flags>&, const FileMatchCallback& callback, unsigned int threadCount=0) {
+            return util::searchFile(filepath, [](std::string_view line, size_t begin) -> std::optional<std::string_view> {
+                // a pattern starting with ^ can only match at the beginning of the line
+                if (begin > 0 and Pattern.view().starts_with('^')) { return std::nullopt; }
+                return static_regex<Pattern, Flags>::find(line.substr(begin));
+            }, callback, threadCount);
+        }
     /// @}
 }
 
 
+namespace gz::re {
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    constexpr bool static_regex<Pattern, Flags>::match(std::string_view sv) {
+        constexpr auto& a = util::regexAutomaton<Pattern, Flags>;
+        if (sv.empty()) { return a.nullable; }
+        auto states = a.first & a.charPositions[static_cast<unsigned char>(sv[0])];
+        for (size_t i = 1; i < sv.size() and states.any(); i++) {
+            states = a.step(states, static_cast<unsigned char>(sv[i]));
+        }
+        return (states & a.last).any();
+    }
+
+
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    constexpr bool static_regex<Pattern, Flags>::search(std::string_view sv) {
+        constexpr auto& a = util::regexAutomaton<Pattern, Flags>;
+        if (a.anchoredStart) {
+            return find(sv).has_value();
+        }
+        // an empty match is possible anywhere (or at the end if anchored)
+        if (a.nullable) { return true; }
+        decltype(a.first) states;
+        for (size_t i = 0; i < sv.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(sv[i]);
+            // start a new match at every char
+            states = a.step(states, c) | (a.first & a.charPositions[c]);
+            if ((states & a.last).any() and (!a.anchoredEnd or i + 1 == sv.size())) { return true; }
+        }
+        return false;
+    }
+
+
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    constexpr std::optional<std::string_view> static_regex<Pattern, Flags>::find(std::string_view sv) {
+        constexpr auto& a = util::regexAutomaton<Pattern, Flags>;
+        for (size_t begin = 0; begin <= sv.size(); begin++) {
+            if (a.anchoredStart and begin > 0) { break; }
+            size_t end = std::string_view::npos;
+            if (a.nullable and (!a.anchoredEnd or begin == sv.size())) { end = begin; }
+            if (begin < sv.size()) {
+                auto states = a.first & a.charPositions[static_cast<unsigned char>(sv[begin])];
+                for (size_t i = begin; states.any(); ) {
+                    i++;
+                    if ((states & a.last).any() and (!a.anchoredEnd or i == sv.size())) { end = i; }
+                    if (i == sv.size()) { break; }
+                    states = a.step(states, static_cast<unsigned char>(sv[i]));
+                }
+            }
+            if (end != std::string_view::npos) {
+                return sv.substr(begin, end - begin);
+            }
+        }
+        return std::nullopt;
+    }
+
+
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    bool regex_match(std::string_view sv, svmatch& m, const static_regex<Pattern, Flags>&) {
+        std::optional<std::string_view> match;
+        if (static_regex<Pattern, Flags>::match(sv)) { match = sv; }
+        util::setRegexMatch(m, sv, match);
+        return match.has_value();
+    }
+
+
+    template<fixed_string Pattern, std::regex::flag_type Flags>
+    bool regex_search(std::string_view sv, svmatch& m, const static_regex<Pattern, Flags>&) {
+        std::optional<std::string_view> match = static_regex<Pattern, Flags>::find(sv);
+        util::setRegexMatch(m, sv, match);
+        return match.has_value();
+    }
+} // namespace gz::re
+
 /**
  * @file
- * @brief Utility for using regex with std::string_view and some regular expressions
+ * @brief Utility for using regex with std::string_view, a compile time regex engine and some regular expressions
  */
@@ -1,80 +1,189 @@
 #include "conversion.hpp"
 #include "../exceptions.hpp"
-#include "../regex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 
 namespace gz {
 
+namespace {
+    inline bool isDigit(char c) {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+    /// Same as \w in a regex
+    inline bool isWordChar(char c) {
+        return isDigit(c) or static_cast<unsigned char>((c | 0x20) - 'a') < 26 or c == '_';
+    }
+    /// @returns true if s and lower are equal, ignoring the case of s. lower must be lowercase letters.
+    inline bool equalsIgnoreCase(std::string_view s, std::string_view lower) {
+        if (s.size() != lower.size()) { return false; }
+        for (size_t i = 0; i < s.size(); i++) {
+            if ((s[i] | 0x20) != lower[i]) { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Advance p over decimal digits
+     * @details Checks 8 chars at once while possible
+     * @returns The number of digits
+     */
+    size_t scanDigits(const char*& p, const char* end) {
+        const char* begin = p;
+        while (end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            // all bytes must be 0x30-0x39: high nibble 3 and adding 6 must not carry into the high nibble
+            constexpr uint64_t HIGH = 0xf0f0f0f0f0f0f0f0;
+            constexpr uint64_t THREES = 0x3030303030303030;
+            if ((word & HIGH) != THREES or ((word + 0x0606060606060606) & HIGH) != THREES) { break; }
+            p += 8;
+        }
+        while (p != end and isDigit(*p)) { p++; }
+        return static_cast<size_t>(p - begin);
+    }
+
+    /// (\d+\.?\d*)|(\d*\.?\d+)
+    bool scanDecimal(const char*& p, const char* end) {
+        size_t digits = scanDigits(p, end);
+        if (p != end and *p == '.') {
+            p++;
+            digits += scanDigits(p, end);
+        }
+        return digits > 0;
+    }
+
+    /// [+\-]?\d+, used for exponents
+    bool scanExponent(const char*& p, const char* end) {
+        if (p != end and (*p == '+' or *p == '-')) { p++; }
+        return scanDigits(p, end) > 0;
+    }
+
+    /// intT and uintT: sign?(0x|0X)?\d+
+    bool scanInt(std::string_view s, bool allowMinus) {
+        const char* p = s.data();
+        const char* end = s.data() + s.size();
+        if (p != end and (*p == '+' or (allowMinus and *p == '-'))) { p++; }
+        // the prefix must be followed by (decimal) digits
+        if (end - p > 2 and p[0] == '0' and (p[1] == 'x' or p[1] == 'X') and isDigit(p[2])) { p += 2; }
+        return scanDigits(p, end) > 0 and p == end;
+    }
+}
+
+
 bool isInt(const std::string& s) {
-    return std::regex_match(s, re::types::intT);
+    return isInt(std::string_view(s));
 }
 bool isInt(const std::string_view& s) {
-    return re::regex_match(s, re::types::intT);
+    return scanInt(s, true);
 }
 bool isUInt(const std::string& s) {
-    return std::regex_match(s, re::types::uintT);
+    return isUInt(std::string_view(s));
 }
 bool isUInt(const std::string_view& s) {
-    return re::regex_match(s, re::types::uintT);
+    return scanInt(s, false);
 }
-bool isFloal(const std::string& s) {
-    return std::regex_match(s, re::types::floatT);
+bool isFloat(const std::string& s) {
+    return isFloat(std::string_view(s));
 }
 bool isFloat(const std::string_view& s) {
-    return re::regex_match(s, re::types::floatT);
+    // case insensitive: [+\-]?decimal(e[+\-]?\d+)? | inf(inity)? | nan\w* | 0xdecimal(p[+\-]?\d+)?
+    if (s.size() >= 3 and equalsIgnoreCase(s.substr(0, 3), "nan")) {
+        return std::all_of(s.begin() + 3, s.end(), isWordChar);
+    }
+    if (equalsIgnoreCase(s, "inf") or equalsIgnoreCase(s, "infinity")) { return true; }
+
+    const char* p = s.data();
+    const char* end = s.data() + s.size();
+    char exponent = 'e';
+    if (s.size() >= 2 and s[0] == '0' and (s[1] | 0x20) == 'x') {
+        // hex: no sign, decimal digits and p exponent
+        p += 2;
+        exponent = 'p';
+    }
+    else if (p != end and (*p == '+' or *p == '-')) { p++; }
+
+    if (!scanDecimal(p, end)) { return false; }
+    if (p != end and (*p | 0x20) == exponent) {
+        p++;
+        if (!scanExponent(p, end)) { return false; }
+    }
+    return p == end;
 }
 
 
-int getIntOr(const std::string& s, int fallback) noexcept {
-    try {
-        fallback = std::stoi(s);
+namespace {
+    /**
+     * @brief Like tryFromString, but also accepts hexadecimal numbers prefixed with 0x or 0X
+     */
+    template<std::integral T>
+    std::errc tryIntFromString(std::string_view s, T& value) noexcept {
+        size_t i = (!s.empty() and (s[0] == '+' or s[0] == '-')) ? 1 : 0;
+        if (s.size() < i + 3 or s[i] != '0' or (s[i + 1] | 0x20) != 'x') {
+            return tryFromString(s, value);
+        }
+        bool negative = s[0] == '-';
+        if (std::is_unsigned_v<T> and negative) { return std::errc::invalid_argument; }
+        // parse the magnitude, from_chars does not accept a sign for unsigned types
+        using U = std::make_unsigned_t<T>;
+        U magnitude;
+        auto result = std::from_chars(s.data() + i + 2, s.data() + s.size(), magnitude, 16);
+        if (result.ec != std::errc()) { return result.ec; }
+        if (result.ptr != s.data() + s.size()) { return std::errc::invalid_argument; }
+        U limit = static_cast<U>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        if (magnitude > limit) { return std::errc::result_out_of_range; }
+        value = static_cast<T>(negative ? static_cast<U>(0) - magnitude : magnitude);
+        return std::errc();
     }
-    catch (...) {}
+}
+
+
+int getIntOr(std::string_view s, int fallback) noexcept {
+    tryIntFromString(s, fallback);
     return fallback;
 }
 
 
-unsigned int getUnsignedIntOr(const std::string& s, unsigned int fallback) noexcept {
-    try {
-        fallback = std::stoul(s);
-    }
-    catch (...) {}
+unsigned int getUnsignedIntOr(std::string_view s, unsigned int fallback) noexcept {
+    tryIntFromString(s, fallback);
     return fallback;
 }
 
 
-double getDoubleOr(const std::string& s, double fallback) noexcept {
-    try {
-        fallback = std::stod(s);
-    }
-    catch (...) {}
+double getDoubleOr(std::string_view s, double fallback) noexcept {
+    tryFromString(s, fallback);
     return fallback;
 }
 
 
-float getFloatOr(const std::string& s, float fallback) noexcept {
-    try {
-        fallback = std::stof(s);
-    }
-    catch (...) {}
+float getFloatOr(std::string_view s, float fallback) noexcept {
+    tryFromString(s, fallback);
     return fallback;
 }
 
 
-bool getBoolOr(const std::string& s, bool fallback) noexcept {
-    if (s == "true" or s == "True" or s == "1") {
-        fallback = true;
-    }
-    else if (s == "false" or s == "False" or s == "0") {
-        fallback = false;
-    }
+bool getBoolOr(std::string_view s, bool fallback) noexcept {
+    tryFromString(s, fallback);
     return fallback;
 }
 
 
-std::string getStringOr(const std::string& s, const std::string& fallback) noexcept {
-    if (s == "") { return fallback; }
-    else { return s; }
+std::string getStringOr(std::string_view s, std::string_view fallback) noexcept {
+    if (s.empty()) { return std::string(fallback); }
+    else { return std::string(s); }
 }
 
 
@@ -105,15 +214,361 @@ std::string getStringOr(const std::string& s, const std::string& fallback) noexc
 // CONVERT FROM STRING
 //
 template<>
-bool fromString<bool>(const std::string& s) { 
-    if (s == "true" or s == "True" or s == "1") {
-        return true;
+bool fromString<bool>(std::string_view s) { 
+    bool b;
+    if (tryFromString(s, b) != std::errc()) {
+        throw InvalidArgument("s is not a bool: '" + std::string(s) + "'", "fromString<bool>");
+    }
+    return b;
+}
+
+
+
+//
+// HEX
+//
+namespace {
+    /// The two hexadecimal digits for every byte
+    constexpr std::array<char, 512> HEX_PAIRS = []() {
+        std::array<char, 512> pairs{};
+        for (size_t i = 0; i < 256; i++) {
+            pairs[2 * i] = util::DIGITS[i >> 4];
+            pairs[2 * i + 1] = util::DIGITS[i & 0xf];
+        }
+        return pairs;
+    }();
+
+    inline char* writeHexByte(char* out, std::byte b) {
+        std::memcpy(out, &HEX_PAIRS[2 * static_cast<size_t>(b)], 2);
+        return out + 2;
     }
-    else if (s == "false" or s == "False" or s == "0") {
-        return false;
+}
+
+
+void hexEncode(std::span<const std::byte> data, char* out) {
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i lowNibble = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero = _mm_set1_epi8('0');
+    // distance from '9' + 1 to 'a'
+    const __m128i letterOffset = _mm_set1_epi8('a' - '0' - 10);
+    auto toChars = [&](__m128i nibbles) {
+        __m128i isLetter = _mm_cmpgt_epi8(nibbles, nine);
+        return _mm_add_epi8(_mm_add_epi8(nibbles, zero), _mm_and_si128(isLetter, letterOffset));
+    };
+    for (; i + 16 <= data.size(); i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i));
+        __m128i high = toChars(_mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibble));
+        __m128i low = toChars(_mm_and_si128(bytes, lowNibble));
+        // interleave high and low digits
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+#endif
+    for (; i < data.size(); i++) {
+        writeHexByte(out + 2 * i, data[i]);
     }
-    throw InvalidArgument("s is not a bool: '" + s + "'", "fromString<bool>");
 }
 
 
+std::string hexdump(std::span<const std::byte> data, size_t bytesPerLine) {
+    if (bytesPerLine == 0) {
+        throw InvalidArgument("bytesPerLine must not be 0", "hexdump");
+    }
+    const int offsetDigits = data.size() > 0xffffffff ? 16 : 8;
+    // offset, 2 spaces, "xx " per byte, an extra space after every 8 bytes, " |", chars, "|\n"
+    const size_t hexWidth = 3 * bytesPerLine + (bytesPerLine - 1) / 8;
+    const size_t lineCount = (data.size() + bytesPerLine - 1) / bytesPerLine;
+    std::string s(lineCount * (offsetDigits + 2 + hexWidth + 2 + 2) + data.size(), ' ');
+
+    std::string encoded(2 * bytesPerLine, '0');
+    char* out = s.data();
+    for (size_t offset = 0; offset < data.size(); offset += bytesPerLine) {
+        out = util::toPowerOf2Chars<4>(out, out + offsetDigits, offset, offsetDigits, "").ptr + 2;
+        std::span<const std::byte> line = data.subspan(offset, std::min(bytesPerLine, data.size() - offset));
+        char* hexBegin = out;
+        // encode the line at once, then spread the digit pairs
+        hexEncode(line, encoded.data());
+        for (size_t i = 0; i < line.size(); i++) {
+            if (i > 0 and i % 8 == 0) { out++; }
+            std::memcpy(out, &encoded[2 * i], 2);
+            out += 3;
+        }
+        // the last line is padded with the spaces that are already there
+        out = hexBegin + hexWidth + 1;
+        *out++ = '|';
+        for (std::byte b : line) {
+            unsigned char c = static_cast<unsigned char>(b);
+            *out++ = static_cast<unsigned char>(c - 0x20) < 0x5f ? static_cast<char>(c) : '.';
+        }
+        *out++ = '|';
+        *out++ = '\n';
+    }
+    return s;
+}
+
+
+//
+// PARSE NUMBERS
+//
+namespace {
+    inline bool isWhitespace(char c) {
+        return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+    }
+
+    /// Find the first whitespace or separator in [p, end)
+    const char* findDelimiter(const char* p, const char* end, char separator) {
+#ifdef __SSE2__
+        const __m128i sep = _mm_set1_epi8(separator);
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriageReturn = _mm_set1_epi8('\r');
+        for (; end - p >= 16; p += 16) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i isDelimiter = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chars, sep), _mm_cmpeq_epi8(chars, space)),
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, tab), _mm_cmpeq_epi8(chars, newline)), _mm_cmpeq_epi8(chars, carriageReturn)));
+            int mask = _mm_movemask_epi8(isDelimiter);
+            if (mask != 0) { return p + __builtin_ctz(static_cast<unsigned int>(mask)); }
+        }
+#endif
+        while (p != end and *p != separator and !isWhitespace(*p)) { p++; }
+        return p;
+    }
+
+    /// Count the occurences of c in s
+    size_t countChar(std::string_view s, char c) {
+        size_t count = 0;
+        size_t i = 0;
+#ifdef __SSE2__
+        const __m128i needle = _mm_set1_epi8(c);
+        for (; i + 16 <= s.size(); i += 16) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + i));
+            count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, needle)))));
+        }
+#endif
+        for (; i < s.size(); i++) {
+            if (s[i] == c) { count++; }
+        }
+        return count;
+    }
+
+    /// Guess the number of numbers in s, to reserve memory
+    size_t estimateNumberCount(std::string_view s, char separator) {
+        if (separator == '\n' or !isWhitespace(separator)) {
+            return countChar(s, separator) + (separator == '\n' ? 0 : countChar(s, '\n')) + 1;
+        }
+        // whitespace separated numbers can be padded with any number of separators
+        return 0;
+    }
+
+    /**
+     * @brief Parse the numbers in s and pass each to emit
+     * @param expectNumber Whether s must start with a number, because it follows a separator
+     * @param offset Offset of s in the original string, for error messages
+     */
+    template<typename T, typename Emit>
+    void parseNumbersChunk(std::string_view s, char separator, bool expectNumber, size_t offset, Emit&& emit) {
+        const char* const begin = s.data();
+        const char* const end = begin + s.size();
+        const char* p = begin;
+        auto getOffset = [&](const char* pos) { return std::to_string(offset + static_cast<size_t>(pos - begin)); };
+        while (true) {
+            while (p != end and isWhitespace(*p)) { p++; }
+            if (p == end) {
+                if (expectNumber) {
+                    throw InvalidArgument("Missing number after separator at offset " + getOffset(p), "parseNumbers");
+                }
+                return;
+            }
+            const char* tokenEnd = findDelimiter(p, end, separator);
+            if (tokenEnd == p) {
+                throw InvalidArgument("Empty field at offset " + getOffset(p), "parseNumbers");
+            }
+            std::string_view token(p, static_cast<size_t>(tokenEnd - p));
+            T value;
+            std::errc error = tryFromString<T>(token, value);
+            if (error == std::errc::result_out_of_range) {
+                throw InvalidArgument("'" + std::string(token) + "' at offset " + getOffset(p) + " is out of range", "parseNumbers");
+            }
+            else if (error != std::errc()) {
+                throw InvalidArgument("'" + std::string(token) + "' at offset " + getOffset(p) + " is not a valid number", "parseNumbers");
+            }
+            emit(value);
+
+            p = tokenEnd;
+            while (p != end and isWhitespace(*p)) { p++; }
+            expectNumber = p != end and *p == separator;
+            if (expectNumber) { p++; }
+        }
+    }
+
+    /// Inputs smaller than this are not split into multiple chunks
+    constexpr size_t PARSE_NUMBERS_MIN_CHUNK_SIZE = 1 << 20;
+
+    struct NumberChunk {
+        std::string_view s;
+        size_t offset;
+        bool expectNumber;
+    };
+
+    /**
+     * @brief Split s into at most chunkCount chunks, so that each chunk starts and ends at a delimiter
+     * @details
+     *  If a chunk ends at a separator, the separator is removed and the next chunk must start with a number.
+     */
+    std::vector<NumberChunk> splitNumberChunks(std::string_view s, char separator, size_t chunkCount) {
+        std::vector<NumberChunk> chunks;
+        size_t begin = 0;
+        bool expectNumber = false;
+        for (size_t i = 1; i < chunkCount; i++) {
+            size_t nominal = std::max(s.size() / chunkCount * i, begin);
+            const char* p = findDelimiter(s.data() + nominal, s.data() + s.size(), separator);
+            while (p != s.data() + s.size() and isWhitespace(*p)) { p++; }
+            size_t boundary = static_cast<size_t>(p - s.data());
+            if (boundary == s.size()) { break; }
+            // p is at a separator or at the start of a number, in which case the whitespace before it might follow a separator
+            size_t previous = boundary;
+            while (previous > begin and isWhitespace(s[previous - 1])) { previous--; }
+            if (previous > begin and s[previous - 1] == separator) { boundary = previous - 1; }
+            chunks.push_back({ s.substr(begin, boundary - begin), begin, expectNumber });
+            expectNumber = s[boundary] == separator;
+            begin = expectNumber ? boundary + 1 : boundary;
+        }
+        chunks.push_back({ s.substr(begin), begin, expectNumber });
+        return chunks;
+    }
+}
+
+
+template<util::ParsableNumber T>
+std::vector<T> parseNumbers(std::string_view s, char separator, unsigned int threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    size_t chunkCount = std::min(static_cast<size_t>(threadCount), s.size() / PARSE_NUMBERS_MIN_CHUNK_SIZE);
+    if (chunkCount <= 1) {
+        std::vector<T> numbers;
+        numbers.reserve(estimateNumberCount(s, separator));
+        parseNumbersChunk<T>(s, separator, false, 0, [&numbers](T t) { numbers.push_back(t); });
+        return numbers;
+    }
+
+    std::vector<NumberChunk> chunks = splitNumberChunks(s, separator, chunkCount);
+    std::vector<std::vector<T>> results(chunks.size());
+    std::vector<std::exception_ptr> errors(chunks.size());
+    auto parseChunk = [&](size_t i) {
+        try {
+            results[i].reserve(estimateNumberCount(chunks[i].s, separator));
+            parseNumbersChunk<T>(chunks[i].s, separator, chunks[i].expectNumber, chunks[i].offset, [&result=results[i]](T t) { result.push_back(t); });
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 1; i < chunks.size(); i++) {
+            threads.emplace_back(parseChunk, i);
+        }
+        parseChunk(0);
+    }
+    for (auto& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+
+    size_t count = 0;
+    for (auto& result : results) { count += result.size(); }
+    std::vector<T> numbers;
+    numbers.reserve(count);
+    for (auto& result : results) {
+        numbers.insert(numbers.end(), result.begin(), result.end());
+    }
+    return numbers;
+}
+
+
+template<util::ParsableNumber T>
+size_t parseNumbers(std::string_view s, std::span<T> out, char separator) {
+    size_t count = 0;
+    parseNumbersChunk<T>(s, separator, false, 0, [&out, &count](T t) {
+        if (count == out.size()) {
+            throw InvalidArgument("s holds more than " + std::to_string(out.size()) + " numbers", "parseNumbers");
+        }
+        out[count++] = t;
+    });
+    return count;
+}
+
+template std::vector<int> parseNumbers<int>(std::string_view, char, unsigned int);
+template std::vector<long> parseNumbers<long>(std::string_view, char, unsigned int);
+template std::vector<long long> parseNumbers<long long>(std::string_view, char, unsigned int);
+template std::vector<unsigned int> parseNumbers<unsigned int>(std::string_view, char, unsigned int);
+template std::vector<unsigned long> parseNumbers<unsigned long>(std::string_view, char, unsigned int);
+template std::vector<unsigned long long> parseNumbers<unsigned long long>(std::string_view, char, unsigned int);
+template std::vector<float> parseNumbers<float>(std::string_view, char, unsigned int);
+template std::vector<double> parseNumbers<double>(std::string_view, char, unsigned int);
+template std::vector<long double> parseNumbers<long double>(std::string_view, char, unsigned int);
+
+template size_t parseNumbers<int>(std::string_view, std::span<int>, char);
+template size_t parseNumbers<long>(std::string_view, std::span<long>, char);
+template size_t parseNumbers<long long>(std::string_view, std::span<long long>, char);
+template size_t parseNumbers<unsigned int>(std::string_view, std::span<unsigned int>, char);
+template size_t parseNumbers<unsigned long>(std::string_view, std::span<unsigned long>, char);
+template size_t parseNumbers<unsigned long long>(std::string_view, std::span<unsigned long long>, char);
+template size_t parseNumbers<float>(std::string_view, std::span<float>, char);
+template size_t parseNumbers<double>(std::string_view, std::span<double>, char);
+template size_t parseNumbers<long double>(std::string_view, std::span<long double>, char);
+
+
+//
+// FORMAT NUMBERS
+//
+namespace util {
+    template<_FormatsInParallel T>
+    void toStringAppendParallel(std::string& out, std::span<const T> numbers, unsigned int threadCount) {
+        if (threadCount == 0) {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        const size_t chunkCount = std::max(std::min(static_cast<size_t>(threadCount), numbers.size() / (TO_STRING_PARALLEL_MIN_SIZE / 2)), static_cast<size_t>(1));
+        // every number except the last one is followed by ", "
+        std::vector<std::string> parts(chunkCount);
+        auto formatChunk = [&](size_t i) {
+            const size_t begin = numbers.size() * i / chunkCount;
+            const size_t end = numbers.size() * (i + 1) / chunkCount;
+            std::string& part = parts[i];
+            for (size_t j = begin; j < end; j++) {
+                toStringAppend(part, numbers[j]);
+                if (j + 1 != numbers.size()) { part += ", "; }
+            }
+        };
+        {
+            std::vector<std::jthread> threads;
+            for (size_t i = 1; i < chunkCount; i++) {
+                threads.emplace_back(formatChunk, i);
+            }
+            formatChunk(0);
+        }
+
+        size_t size = out.size() + 4;
+        for (const std::string& part : parts) { size += part.size(); }
+        out.reserve(size);
+        out += "[ ";
+        for (const std::string& part : parts) { out += part; }
+        out += " ]";
+    }
+
+    template void toStringAppendParallel<int>(std::string&, std::span<const int>, unsigned int);
+    template void toStringAppendParallel<long>(std::string&, std::span<const long>, unsigned int);
+    template void toStringAppendParallel<long long>(std::string&, std::span<const long long>, unsigned int);
+    template void toStringAppendParallel<unsigned int>(std::string&, std::span<const unsigned int>, unsigned int);
+    template void toStringAppendParallel<unsigned long>(std::string&, std::span<const unsigned long>, unsigned int);
+    template void toStringAppendParallel<unsigned long long>(std::string&, std::span<const unsigned long long>, unsigned int);
+    template void toStringAppendParallel<float>(std::string&, std::span<const float>, unsigned int);
+    template void toStringAppendParallel<double>(std::string&, std::span<const double>, unsigned int);
+    template void toStringAppendParallel<long double>(std::string&, std::span<const long double>, unsigned int);
+} // namespace util
+
 } // namespace gz
@@ -3,19 +3,22 @@
 #include "to_string.hpp"
 #include "from_string.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <string>
-#include <bitset>
-
-#ifdef FORMAT 
-#include <format>
-#else
-#include <sstream>
-#include <iomanip>
-#endif
+#include <type_traits>
+#include <vector>
 
 namespace gz {
     /**
-     * @name Functions that determine if s is a string representation of a certain type, using regex.
+     * @name Functions that determine if s is a string representation of a certain type
+     * @details
+     *  These accept the same strings as the regular expressions re::types::intT, re::types::uintT and re::types::floatT,
+     *  but scan the string directly instead of using std::regex.
      * @{
      */
         bool isInt(const std::string& s);
@@ -31,43 +34,113 @@ namespace gz {
 
     /**
      * @name Convert to type or return fallback
-     * @todo Use string_views without constructing a std::string
+     * @details
+     *  These functions do not allocate and do not throw, see tryFromString() for the accepted formats.
+     *  Additionally, the integer functions accept hexadecimal numbers with a `0x` or `0X` prefix, like re::types::intT.
      * @{
      */
-        int getIntOr(const std::string& s, int fallback=0) noexcept;
-        inline int getIntOr(const std::string_view& s, int fallback=0) noexcept { return getIntOr(std::string(s), fallback); }
-
-        unsigned int getUnsignedIntOr(const std::string& s, unsigned int fallback=0) noexcept;
-        /* inline unsigned int getUnsignedIntOr(const std::string&& s, unsigned int fallback=0) { return getUnsignedIntOr(s, fallback); } */
-        inline unsigned int getUnsignedIntOr(const std::string_view& s, unsigned int fallback=0) noexcept { return getUnsignedIntOr(std::string(s), fallback); }
-
-        double getDoubleOr(const std::string& s, double fallback=0) noexcept;
-        /* inline double getDoubleOr(const std::string&& s, double fallback=0) { return getDoubleOr(s, fallback); } */
-        inline double getDoubleOr(const std::string_view& s, double fallback=0) noexcept { return getDoubleOr(std::string(s), fallback); }
-
-        float getFloatOr(const std::string& s, float fallback=0) noexcept;
-        /* inline float getFloatOr(const std::string&& s, float fallback=0) { return getDoubleOr(s, fallback); } */
-        inline float getFloatOr(const std::string_view& s, float fallback=0) noexcept { return getDoubleOr(std::string(s), fallback); }
-
-        bool getBoolOr(const std::string& s, bool fallback=false) noexcept;
-        /* inline bool getBoolOr(const std::string&& s, bool fallback=false) { return getBoolOr(s, fallback); } */
-        inline bool getBoolOr(const std::string_view& s, bool fallback=false) noexcept { return getBoolOr(std::string(s), fallback); }
+        int getIntOr(std::string_view s, int fallback=0) noexcept;
+        unsigned int getUnsignedIntOr(std::string_view s, unsigned int fallback=0) noexcept;
+        double getDoubleOr(std::string_view s, double fallback=0) noexcept;
+        float getFloatOr(std::string_view s, float fallback=0) noexcept;
+        /**
+         * @brief Returns true for "true" and "1", false for "false" and "0" (case insensitive), fallback otherwise
+         */
+        bool getBoolOr(std::string_view s, bool fallback=false) noexcept;
 
         /**
          * @brief Returns the string or fallback if string is empty.
          */
-        std::string getStringOr(const std::string& s, const std::string& fallback="none") noexcept;
+        std::string getStringOr(std::string_view s, std::string_view fallback="none") noexcept;
     /// @}
      
     //
     // HEX/OCT
     //
+    namespace util {
+        /// Digits for all bases <= 16
+        inline constexpr char DIGITS[] = "0123456789abcdef";
+
+        /// @returns The number of digits t has in base 2^BITS
+        template<unsigned BITS, std::integral T>
+        constexpr int countDigits(T t) {
+            auto u = static_cast<std::make_unsigned_t<T>>(t);
+            int digits = 1;
+            while (u >>= BITS) { digits++; }
+            return digits;
+        }
+
+        /**
+         * @brief Write prefix and t in base 2^BITS with at least minDigits digits (padded with 0) into [first, last)
+         * @details Negative numbers are written as their two's complement.
+         */
+        template<unsigned BITS, std::integral T>
+        constexpr std::to_chars_result toPowerOf2Chars(char* first, char* last, T t, int minDigits, std::string_view prefix) {
+            auto u = static_cast<std::make_unsigned_t<T>>(t);
+            size_t count = prefix.size() + static_cast<size_t>(std::max(countDigits<BITS>(t), minDigits));
+            if (static_cast<size_t>(last - first) < count) {
+                return { last, std::errc::value_too_large };
+            }
+            std::copy(prefix.begin(), prefix.end(), first);
+            char* digitsBegin = first + prefix.size();
+            for (char* p = first + count; p != digitsBegin; u >>= BITS) {
+                *--p = DIGITS[u & ((1u << BITS) - 1)];
+            }
+            return { first + count, std::errc() };
+        }
+
+        template<unsigned BITS, std::integral T>
+        std::string toPowerOf2String(T t, int minDigits, std::string_view prefix) {
+            std::string s(prefix.size() + static_cast<size_t>(std::max(countDigits<BITS>(t), minDigits)), '0');
+            toPowerOf2Chars<BITS>(s.data(), s.data() + s.size(), t, minDigits, prefix);
+            return s;
+        }
+
+        /**
+         * @brief Parse an integer in the given base, with an optional '-' and prefix
+         * @details
+         *  Without a '-', every value that fits into the unsigned version of T is accepted and interpreted as two's complement,
+         *  so that the output of toPowerOf2String() can be parsed again.
+         * @throws std::invalid_argument if s is not a valid number
+         * @throws std::out_of_range if s does not fit into T
+         */
+        template<std::integral T>
+        T fromBaseString(std::string_view s, int base, std::string_view prefix) {
+            using U = std::make_unsigned_t<T>;
+            bool negative = s.starts_with('-');
+            if (negative) { s.remove_prefix(1); }
+            // prefix is case insensitive
+            if (s.size() >= prefix.size() and std::equal(prefix.begin(), prefix.end(), s.begin(), [](char p, char c) { return p == c or (p >= 'a' and p == (c | 0x20)); })) {
+                s.remove_prefix(prefix.size());
+            }
+            U magnitude;
+            auto result = std::from_chars(s.data(), s.data() + s.size(), magnitude, base);
+            if (result.ec == std::errc() and result.ptr != s.data() + s.size()) {
+                result.ec = std::errc::invalid_argument;
+            }
+            else if (result.ec == std::errc() and negative and magnitude != 0) {
+                if (std::is_unsigned_v<T>) { result.ec = std::errc::invalid_argument; }
+                else if (magnitude > static_cast<U>(std::numeric_limits<T>::max()) + 1) { result.ec = std::errc::result_out_of_range; }
+            }
+            if (result.ec == std::errc::result_out_of_range) {
+                throw std::out_of_range("'" + std::string(s) + "' does not fit into the integer type");
+            }
+            else if (result.ec != std::errc()) {
+                throw std::invalid_argument("'" + std::string(s) + "' is not a valid base " + std::to_string(base) + " number");
+            }
+            return static_cast<T>(negative ? static_cast<U>(0) - magnitude : magnitude);
+        }
+    } // namespace util
+
     /**
      * @name Converting an integer to/from a hex/oct/bin string
-     * @todo Move to std::format, when P0645R10 is implemented in gcc libstd
-     * @note 
-     *  The fromHexString() and fromOctString() functions use `std::hex`, while fromBinString() uses `std::bitset`. Both can throw `std::invalid_argument` and the latter can also throw `std::out_of_range`.
-     *  See https://en.cppreference.com/w/cpp/utility/bitset/bitset and https://en.cppreference.com/w/cpp/io/manip/hex
+     * @details
+     *  The to*String() functions write the two's complement of negative numbers, eg. `toHexString<int8_t>(-1) == "0xff"`.
+     *  The to*Chars() functions do the same, but write into the caller provided buffer [first, last) without allocating.
+     *  If the buffer is too small, they return `{ last, std::errc::value_too_large }`.
+     *
+     *  The from*String() functions accept an optional '-' and an optional prefix.
+     *  They throw `std::invalid_argument` if s is not a valid number and `std::out_of_range` if it does not fit into T.
      */
     /// @{
         /**
@@ -78,24 +151,20 @@ namespace gz {
          */
         template<std::integral T>
         std::string toHexString(const T& t, char digits=sizeof(T)*2) {
-#ifdef FORMAT
-            return std::format("{:#0" + std::to_string(digits) + "x}", t);
-#endif
-            std::stringstream ss;
-            ss << "0x" << std::setfill('0') << std::setw(digits) << std::hex << t;
-            return std::string(ss.str());
+            return util::toPowerOf2String<4>(t, digits, "0x");
+        }
+        /// @brief Write t as hexadecimal number (prefixed with 0x) to [first, last), see toHexString()
+        template<std::integral T>
+        std::to_chars_result toHexChars(char* first, char* last, const T& t, char digits=sizeof(T)*2) {
+            return util::toPowerOf2Chars<4>(first, last, t, digits, "0x");
         }
 
         /**
          * @brief Convert a hexadecimal string (may be prefixed with 0x) to integer
          */
         template<std::integral T>
-        T fromHexString(const std::string& s) {
-            T t;
-            std::stringstream ss;
-            ss << std::hex << s;
-            ss >> t;
-            return t;
+        T fromHexString(std::string_view s) {
+            return util::fromBaseString<T>(s, 16, "0x");
         }
 
         /**
@@ -106,25 +175,21 @@ namespace gz {
          */
         template<std::integral T>
         std::string toOctString(const T& t, char digits=sizeof(T)*4) {
-#ifdef FORMAT
-            // TODO test when possible
-            return std::format("{:#0" + std::to_string(digits) + "o}", t);
-#endif
-            std::stringstream ss;
-            ss << "0" << std::setfill('0') << std::setw(digits) << std::oct << t;
-            return std::string(ss.str());
+            return util::toPowerOf2String<3>(t, digits, "0");
+        }
+        /// @brief Write t as octal number (prefixed with 0) to [first, last), see toOctString()
+        template<std::integral T>
+        std::to_chars_result toOctChars(char* first, char* last, const T& t, char digits=sizeof(T)*4) {
+            return util::toPowerOf2Chars<3>(first, last, t, digits, "0");
         }
 
         /**
          * @brief Convert an octal string (may be prefixed with 0) to integer
          */
         template<std::integral T>
-        T fromOctString(const std::string& s) {
-            T t;
-            std::stringstream ss;
-            ss << std::oct << s;
-            ss >> t;
-            return t;
+        T fromOctString(std::string_view s) {
+            // the 0 prefix is just a leading zero
+            return util::fromBaseString<T>(s, 8, "");
         }
 
         /**
@@ -132,24 +197,20 @@ namespace gz {
          */
         template<std::integral T>
         std::string toBinString(const T& t) {
-#ifdef FORMAT
-            // TODO test when possible
-            return std::format("{:#0" + std::to_string(digits) + "b}", t);
-#endif
-            return std::string("0b") + std::bitset<sizeof(T)*8>(t).to_string();
+            return util::toPowerOf2String<1>(t, sizeof(T)*8, "0b");
+        }
+        /// @brief Write t as binary number (prefixed with 0b) to [first, last), see toBinString()
+        template<std::integral T>
+        std::to_chars_result toBinChars(char* first, char* last, const T& t) {
+            return util::toPowerOf2Chars<1>(first, last, t, sizeof(T)*8, "0b");
         }
 
         /**
          * @brief Convert binary string (may be prefixed with 0b) to integer
          */
         template<std::integral T>
-        T fromBinString(const std::string& s) {
-            if (s.starts_with("0b")) {
-                return static_cast<T>(std::bitset<sizeof(T)*8>(s, 2).to_ullong());
-            }
-            else {
-                return static_cast<T>(std::bitset<sizeof(T)*8>(s).to_ullong());
-            }
+        T fromBinString(std::string_view s) {
+            return util::fromBaseString<T>(s, 2, "0b");
         }
 
 
@@ -204,6 +265,64 @@ namespace gz {
             s += " ]";
             return s;
         }
+
+        /**
+         * @brief Write the bytes as hexadecimal numbers to out, without prefix or separators
+         * @details
+         *  out must have space for `2 * data.size()` chars. Uses SSE2 if available.
+         */
+        void hexEncode(std::span<const std::byte> data, char* out);
+
+        /**
+         * @brief Create a hexdump of data, in the format of `hexdump -C`
+         * @details
+         *  Each line holds the offset, bytesPerLine bytes in hexadecimal and the bytes as chars, where non printable chars are replaced with '.':
+         *  @code
+         *   00000000  48 65 6c 6c 6f 2c 20 77  6f 72 6c 64 21 0a        |Hello, world!.|
+         *  @endcode
+         *  To dump the output of readBinaryFile(), use `hexdump(std::as_bytes(std::span(data)))`.
+         * @throws InvalidArgument if bytesPerLine is 0
+         */
+        std::string hexdump(std::span<const std::byte> data, size_t bytesPerLine=16);
+    /// @}
+
+    namespace util {
+        /// Types supported by parseNumbers()
+        template<typename T>
+        concept ParsableNumber = GetTypeFromStringImplemented<T> and !std::same_as<T, bool>;
+    } // namespace util
+
+    /**
+     * @name Parsing many numbers at once
+     * @details
+     *  Parse a whole buffer of numbers, eg. the contents of a csv file, in a single pass.
+     *  Numbers are separated by separator and/or whitespace (space, tab, newline, carriage return),
+     *  so with the default separator `1, 2,3\n4` gives the 4 numbers 1 2 3 4.
+     *  The delimiters are searched for 16 chars at a time using SSE2 (if available) and the numbers are converted with std::from_chars,
+     *  so every number is parsed like tryFromString() would parse it.
+     *
+     *  Empty fields (two separators that are only separated by whitespace, or a trailing separator) are errors.
+     * @throws InvalidArgument if a number is invalid, out of range or missing. The message contains the offset of the error in s.
+     * @{
+     */
+        /**
+         * @brief Parse all numbers in s into a vector
+         * @param threadCount
+         *  Maximum number of threads to use (0 = std::thread::hardware_concurrency()).
+         *  The input is split into chunks at delimiters, which are parsed in parallel.
+         *  Each thread gets at least 1 MiB of input, so small inputs are always parsed on the calling thread.
+         *  If multiple chunks contain errors, the error of the first chunk is thrown.
+         */
+        template<util::ParsableNumber T>
+        std::vector<T> parseNumbers(std::string_view s, char separator=',', unsigned int threadCount=1);
+        /**
+         * @overload
+         * @brief Parse all numbers in s into out, without allocating memory
+         * @returns The number of numbers written to out
+         * @throws InvalidArgument if s holds more than out.size() numbers
+         */
+        template<util::ParsableNumber T>
+        size_t parseNumbers(std::string_view s, std::span<T> out, char separator=',');
     /// @}
 
     /// gz::toString and gz::fromString overloads exist
@@ -245,7 +364,8 @@ namespace gz {
  *   -# Any @ref util::CanConstructString "type that is accepted by the constructor of std::string()" { char, const char* }
  *   -# Any @ref util::WorksWithStdToString "type that works with std::to_string()" { int, double, bool ... }
  *   -# Any @ref util::HasToStringMember "type that has a `toString() const` or `to_string() const` member that returns a string"
- *   -# Any @ref util::ConvertibleToStringGlobal "type where a `std::string toString(const T&)` overload exists in global namespace
+ *   -# Any @ref util::AppendsToStringGlobal "type where a `void toStringAppend(std::string&, const T&)` overload exists in global namespace"
+ *   -# Any @ref util::ConvertibleToStringGlobal "type where a `std::string toString(const T&)` overload exists in global namespace (may also return std::string_view, eg. for enums from gen_enum_str.py)
  *   -# Any of the following (the mentioned members have to satisfy one of 1-5)
  *     - Any @ref util::Vector2ConvertibleToString "type with t.x and t.y"
  *     - Any @ref util::Vector3ConvertibleToString "type with t.x, t.y, t.z"
@@ -266,6 +386,14 @@ namespace gz {
  *  the string is unsuitable for construction. 
  *  In this case, the fromString functions from this library throw an exception (either InvalidArgument, or std::invalid_argument / std::out_of_range).
  *
+ *  @subsection sc_fromString_containers Containers
+ *   Containers can be constructed from the output of toString():
+ *   -# @ref util::ForwardRangeConstructibleFromString "forward ranges" from `[ x1, x2, ... ]` { std::vector<int>, std::set<std::string> }
+ *   -# @ref util::PairConstructibleFromString "pairs" from `( first, second )` { std::pair<int, std::vector<float>> }
+ *   -# @ref util::MapConstructibleFromString "ranges of pairs" from `{ first: second, ... }` { std::map<std::string, std::vector<bool>> }
+ *
+ *   Since strings are not quoted by toString(), string elements must not contain separators or brackets.
+ *
  * @section sc_overloads Overloading the string conversion functions
  *  @subsection sc_ov_toString Overload for toString
  *   If you want your custom type to be convertible to string, you have different options.
@@ -279,6 +407,14 @@ namespace gz {
  *        return s;
  *    }
  *   @endcode
+ *   Alternatively, you can overload `void toStringAppend(std::string& out, const T&)` in global namespace,
+ *   which appends to out instead of returning a new string.
+ *   This saves an allocation when your type is logged or is an element of a container.
+ *
+ *  @subsection sc_ov_toStringAppend Appending to a string
+ *   For every `gz::toString(t)` there is a `gz::toStringAppend(out, t)` that appends to an existing string.
+ *   Containers, pairs and vectors append their elements directly, so they only need a single string.
+ *   @ref Log "Log" appends all arguments directly to the log line.
  *
  *  @subsection sc_ov_fromString Overload for fromString
  *   Writing an overload for fromString needs a little bit more boiler plate.
@@ -360,8 +496,6 @@ namespace gz {
  *    Define the macro `GZ_TO_STRING_NO_VECTORS` before including `<gz-util/string/to_string.hpp>`.
  *    This disables all overloads for Vector and Extent classes.
  *
- *  @todo Implement fromString for ranges that hold ConstructibleFromString types
- *
  * @section sc_int_types Converting integers to/from strings with different base
  *  The functions toHexString(), toOctString() and toBinString() can be used to get a
  *  string of an integers representation in 16 / 8 / 2 basis.
@@ -370,7 +504,11 @@ namespace gz {
  *  from a string representation of an integer in 16 / 8 / 2 basis.
  *  These function can throw std::invalid_argument and std::out_of_range.
  *
- *  @note toHexString() and toOctString() do not work well with `(unsigned) char` (`(u)int8_t`).
+ *  toHexChars(), toOctChars() and toBinChars() write into a caller provided buffer instead.
+ *  hexdump() creates a `hexdump -C` style dump of a byte buffer.
+ *
+ * @section sc_parseNumbers Parsing many numbers
+ *  parseNumbers() parses a buffer of separated numbers directly into a vector or span, optionally using multiple threads.
  *
  *  
  */
@@ -1,7 +1,17 @@
 #pragma once
 
 #include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 
 #define GZ_UTIL_STRING_CONCEPTS
 
@@ -38,62 +48,73 @@ namespace gz::util {
 
 namespace gz {
     /**
-     * @name Construct a type from a string
-     * @note 
-     *  The fromString() functions (except for the bool one) simply return std::stoXX. These can throw std::invalid_argument and std::out_of_range.
-     *  See https://en.cppreference.com/w/cpp/string/basic_string/stol
+     * @name Construct a number from a string_view without allocating
+     * @details
+     *  These functions use std::from_chars, so they do not allocate, do not depend on the locale and
+     *  floating point numbers are parsed exactly (toString() -> fromString() round-trips).
+     *
+     *  The whole string has to be a number:
+     *  - integers: `[+-]?\d+`, unsigned integers must not have a '-'
+     *  - floating point numbers: optional sign, followed by either a decimal number with optional exponent,
+     *    a hexadecimal number with prefix `0x` and optional `p` exponent, `inf`, `infinity` or `nan`
+     *  - bool: see fromString<bool>()
+     *
+     *  Unlike std::stoi, leading whitespace and trailing characters are not allowed.
      */
     /// @{
         /**
-         * @brief Declaration of fromString, but only for the types for which it is implemented
+         * @brief Try to convert s to T
+         * @param value Set to the result if the conversion succeeds, unchanged otherwise
+         * @returns
+         *  - `std::errc()` on success
+         *  - `std::errc::invalid_argument` if s is not a valid representation of T
+         *  - `std::errc::result_out_of_range` if the value does not fit into T
          */
         template<util::GetTypeFromStringImplemented T>
-        T fromString(const std::string& s);
+        std::errc tryFromString(std::string_view s, T& value) noexcept;
 
-        /// @returns std::stoi(s)
-        template<> inline int fromString<int>(const std::string& s) {
-            return std::stoi(s);
-        }
-        /// @returns std::stol(s)
-        template<> inline long fromString<long>(const std::string& s) {
-            return std::stol(s);
-        }
-        /// @returns std::stoll(s)
-        template<> inline long long fromString<long long>(const std::string& s) {
-            return std::stoll(s);
-        }
-        /// @returns std::stoul(s)
-        template<> inline unsigned int fromString<unsigned int>(const std::string& s) {
-            return std::stoul(s);
-        }
-        /// @returns std::stoul(s)
-        template<> inline unsigned long fromString<unsigned long>(const std::string& s) {
-            return std::stoul(s);
-        }
-        /// @returns std::stoull(s)
-        template<> inline unsigned long long fromString<unsigned long long>(const std::string& s) {
-            return std::stoull(s);
-        }
-        /// @returns std::stof(s)
-        template<> inline float fromString<float>(const std::string& s) {
-            return std::stof(s);
-        }
-        /// @returns std::stod(s)
-        template<> inline double fromString<double>(const std::string& s) {
-            return std::stod(s);
-        }
-        /// @returns std::stold(s)
-        template<> inline long double fromString<long double>(const std::string& s) {
-            return std::stold(s);
+        /**
+         * @brief Convert s to T
+         * @throws std::invalid_argument if s is not a valid representation of T (InvalidArgument for bool)
+         * @throws std::out_of_range if the value does not fit into T
+         */
+        template<util::GetTypeFromStringImplemented T>
+        T fromString(std::string_view s);
+
+        /**
+         * @overload
+         * @details Resolves the ambiguity between the std::string and std::string_view overloads for string literals
+         */
+        template<util::GetTypeFromStringImplemented T>
+        inline T fromString(const char* s) {
+            return fromString<T>(std::string_view(s));
         }
+
         /**
          * @brief Convert a string to bool
          * @details
-         *  - returns true if s = "true" or "True" or "1"
-         *  - returns false if s = "false" or "False" or "0"
+         *  - returns true if s = "true" or "1" (case insensitive)
+         *  - returns false if s = "false" or "0" (case insensitive)
          *  - throws InvalidArgument otherwise
          */
-        template<> bool fromString<bool>(const std::string& s);
+        template<> bool fromString<bool>(std::string_view s);
+    /// @}
+
+
+    /**
+     * @name Construct a type from a string
+     * @note 
+     *  For the numeric types and bool, these are the same as the std::string_view overloads.
+     *  They throw std::invalid_argument and std::out_of_range like std::stoXX, but are stricter: see @ref tryFromString.
+     */
+    /// @{
+        /**
+         * @brief Convert s to T, only for the types for which it is implemented
+         */
+        template<util::GetTypeFromStringImplemented T>
+        inline T fromString(const std::string& s) {
+            return fromString<T>(std::string_view(s));
+        }
 
         /**
          * @overload
@@ -106,6 +127,236 @@ namespace gz {
     /// @}
 
 
+}  // namespace gz
+
+
+namespace gz::util {
+    /**
+     * @name Concepts for containers that can be constructed from the output of toString()
+     * @{
+     */
+        /// Types that can be elements of containers: types with a fromString overload and std::string
+        template<typename T>
+        concept _FromStringElement = GetTypeFromStringImplemented<T> or ConstructibleFromStringGlobal<T> or std::same_as<T, std::string>;
+
+        template<typename T>
+        concept _PairLike = requires {
+            typename T::first_type;
+            typename T::second_type;
+        };
+
+        /**
+         * @brief Check if T can be parsed by the fromString() overloads for elements, containers and pairs
+         * @details
+         *  Containers can hold other containers or pairs, so this recurses into the element types.
+         *  This has to be a function, since concepts can not refer to themselves.
+         */
+        template<typename T>
+        consteval bool _isFromStringElementOrContainer() {
+            if constexpr (_FromStringElement<T>) {
+                return true;
+            }
+            else if constexpr (_PairLike<T>) {
+                using First = std::remove_const_t<typename T::first_type>;
+                using Second = typename T::second_type;
+                return std::constructible_from<T, First, Second> and
+                    _isFromStringElementOrContainer<First>() and _isFromStringElementOrContainer<Second>();
+            }
+            else if constexpr (std::ranges::forward_range<T> and std::default_initializable<T> and
+                               requires(T& t, std::ranges::range_value_t<T>&& v) { t.insert(t.end(), std::move(v)); }) {
+                return _isFromStringElementOrContainer<std::ranges::range_value_t<T>>();
+            }
+            else {
+                return false;
+            }
+        }
+
+        /// _FromStringElement types, and containers or pairs that (recursively) hold them
+        template<typename T>
+        concept _FromStringElementOrRange = _isFromStringElementOrContainer<T>();
+
+        /// Container holding _FromStringElementOrRange types that can insert elements at the end, eg. std::vector<int>, std::list<std::string>, std::set<std::vector<float>>
+        template<typename T>
+        concept ForwardRangeConstructibleFromString = !std::same_as<T, std::string> and std::ranges::forward_range<T> and std::default_initializable<T> and
+            !_PairLike<std::ranges::range_value_t<T>> and
+            _FromStringElementOrRange<std::ranges::range_value_t<T>> and
+            requires(T& t, std::ranges::range_value_t<T>&& v) { t.insert(t.end(), std::move(v)); };
+
+        /// Pair whose members are _FromStringElementOrRange types
+        template<typename T>
+        concept PairConstructibleFromString = _PairLike<T> and
+            _FromStringElementOrRange<std::remove_const_t<typename T::first_type>> and
+            _FromStringElementOrRange<typename T::second_type> and
+            std::constructible_from<T, std::remove_const_t<typename T::first_type>, typename T::second_type>;
+
+        /// Container holding pairs of _FromStringElementOrRange types, like std::map<std::string, int> or std::vector<std::pair<int, std::vector<float>>>
+        template<typename T>
+        concept MapConstructibleFromString = std::ranges::forward_range<T> and std::default_initializable<T> and
+            PairConstructibleFromString<std::ranges::range_value_t<T>> and
+            requires(T& t, std::ranges::range_value_t<T>&& v) { t.insert(t.end(), std::move(v)); };
+    /// @}
+}  // namespace gz::util
+
+
+namespace gz {
+    /**
+     * @name Construct a container from a string
+     * @details
+     *  These are the inverse of the toString() functions for containers.
+     *  They parse the string in a single pass, elements are parsed from std::string_views into the original string.
+     *  Whitespace around elements is ignored.
+     *
+     *  Elements can be any type with a fromString() overload, std::string, another container or a pair.
+     *  Ranges of pairs are parsed like maps, since that is how toString() formats them.
+     *  Since toString() does not quote strings, string elements must not contain the separators (`,` and for maps `:`) or brackets.
+     *  @code
+     *   auto v = fromString<std::vector<int>>("[ 1, 2, 3 ]");
+     *   auto m = fromString<std::map<std::string, std::vector<float>>>("{ a: [ 1.5 ], b: [  ] }");
+     *   auto vv = fromString<std::vector<std::vector<int>>>("[ [ 1, 2 ], [  ] ]");
+     *  @endcode
+     * @throws InvalidArgument if the string is not in the expected format
+     * @throws std::invalid_argument, std::out_of_range or InvalidArgument if an element can not be parsed
+     * @{
+     */
+        /**
+         * @brief Construct a forward range from a string
+         * @param s [ x1, x2, ... ]
+         */
+        template<util::ForwardRangeConstructibleFromString T>
+        T fromString(std::string_view s);
+
+        /**
+         * @overload
+         * @brief Construct a pair from a string
+         * @param s ( first, second )
+         */
+        template<util::PairConstructibleFromString T>
+        T fromString(std::string_view s);
+
+        /**
+         * @overload
+         * @brief Construct a forward range holding pairs, eg a map, from a string
+         * @param s { first: second, first: second, ... }
+         */
+        template<util::MapConstructibleFromString T>
+        T fromString(std::string_view s);
+    /// @}
+}  // namespace gz
+
+
+namespace gz::util {
+    inline std::string_view _trimWhitespace(std::string_view s) {
+        constexpr std::string_view WHITESPACE = " \t\n\r";
+        size_t first = s.find_first_not_of(WHITESPACE);
+        if (first == std::string_view::npos) { return std::string_view(); }
+        return s.substr(first, s.find_last_not_of(WHITESPACE) - first + 1);
+    }
+
+    /**
+     * @brief Check that s (without surrounding whitespace) is enclosed by open and close
+     * @returns The content without surrounding whitespace
+     * @throws InvalidArgument if s is not enclosed by open and close
+     */
+    inline std::string_view _unwrap(std::string_view s, char open, char close) {
+        s = _trimWhitespace(s);
+        if (s.size() < 2 or s.front() != open or s.back() != close) {
+            throw InvalidArgument("'" + std::string(s) + "' is not enclosed in '" + open + "' and '" + close + "'", "fromString");
+        }
+        return _trimWhitespace(s.substr(1, s.size() - 2));
+    }
+
+    /**
+     * @brief Find the first separator that is not within brackets
+     * @returns The position of the separator or std::string_view::npos
+     */
+    inline size_t _findSeparator(std::string_view s, char separator) {
+        int depth = 0;
+        for (size_t i = 0; i < s.size(); i++) {
+            char c = s[i];
+            if (c == separator and depth == 0) { return i; }
+            else if (c == '[' or c == '(' or c == '{') { depth++; }
+            else if (c == ']' or c == ')' or c == '}') { depth--; }
+        }
+        return std::string_view::npos;
+    }
+
+    /**
+     * @brief Call f with every (trimmed) element of the separated list s
+     */
+    template<typename F>
+    void _forEachElement(std::string_view s, char separator, F&& f) {
+        if (s.empty()) { return; }
+        while (true) {
+            size_t end = _findSeparator(s, separator);
+            f(_trimWhitespace(s.substr(0, end)));
+            if (end == std::string_view::npos) { return; }
+            s.remove_prefix(end + 1);
+        }
+    }
+
+    /**
+     * @brief Construct a container element from a string_view
+     */
+    template<typename T>
+    T _fromStringElement(std::string_view s) {
+        if constexpr (std::same_as<T, std::string>) {
+            return std::string(s);
+        }
+        else if constexpr (ConstructibleFromStringGlobal<T>) {
+            // the global overloads only take std::string
+            return ::fromString<T>(std::string(s));
+        }
+        else {
+            return fromString<T>(s);
+        }
+    }
+}  // namespace gz::util
+
+
+namespace gz {
+    template<util::ForwardRangeConstructibleFromString T>
+    T fromString(std::string_view s) {
+        using Element = std::ranges::range_value_t<T>;
+        T t;
+        util::_forEachElement(util::_unwrap(s, '[', ']'), ',', [&t](std::string_view element) {
+            t.insert(t.end(), util::_fromStringElement<Element>(element));
+        });
+        return t;
+    }
+
+
+    template<util::PairConstructibleFromString T>
+    T fromString(std::string_view s) {
+        using First = std::remove_const_t<typename T::first_type>;
+        using Second = typename T::second_type;
+        s = util::_unwrap(s, '(', ')');
+        size_t separator = util::_findSeparator(s, ',');
+        if (separator == std::string_view::npos) {
+            throw InvalidArgument("'" + std::string(s) + "' is not a pair, missing ','", "fromString");
+        }
+        return T(util::_fromStringElement<First>(util::_trimWhitespace(s.substr(0, separator))),
+                 util::_fromStringElement<Second>(util::_trimWhitespace(s.substr(separator + 1))));
+    }
+
+
+    template<util::MapConstructibleFromString T>
+    T fromString(std::string_view s) {
+        using Pair = std::ranges::range_value_t<T>;
+        using First = std::remove_const_t<typename Pair::first_type>;
+        using Second = typename Pair::second_type;
+        T t;
+        util::_forEachElement(util::_unwrap(s, '{', '}'), ',', [&t](std::string_view element) {
+            size_t separator = util::_findSeparator(element, ':');
+            if (separator == std::string_view::npos) {
+                throw InvalidArgument("'" + std::string(element) + "' is not a key-value pair, missing ':'", "fromString");
+            }
+            t.insert(t.end(), Pair(util::_fromStringElement<First>(util::_trimWhitespace(element.substr(0, separator))),
+                                   util::_fromStringElement<Second>(util::_trimWhitespace(element.substr(separator + 1)))));
+        });
+        return t;
+    }
+
+
     /**
      * @brief Any type where fromString(string) exists and returns T
      * @note The function only has to exist, it does not have to be noexcept!
@@ -116,8 +367,74 @@ namespace gz {
     };
 }  // namespace gz
 
+namespace gz {
+    template<util::GetTypeFromStringImplemented T>
+    std::errc tryFromString(std::string_view s, T& value) noexcept {
+        if constexpr (std::same_as<T, bool>) {
+            // compare case insensitive by setting the 0x20 bit of every char, which only maps uppercase letters to lowercase ones here
+            auto load = [](const char* p) {
+                uint32_t word = 0;
+                std::memcpy(&word, p, 4);
+                return word | 0x20202020u;
+            };
+            if ((s.size() == 1 and s[0] == '1') or (s.size() == 4 and load(s.data()) == load("true"))) { value = true; }
+            else if ((s.size() == 1 and s[0] == '0') or (s.size() == 5 and load(s.data()) == load("fals") and (s[4] | 0x20) == 'e')) { value = false; }
+            else { return std::errc::invalid_argument; }
+            return std::errc();
+        }
+        else {
+            const char* first = s.data();
+            const char* last = s.data() + s.size();
+            bool negative = false;
+            if constexpr (std::floating_point<T>) {
+                // remove the sign, so that the 0x prefix can be handled
+                if (first != last and (*first == '+' or *first == '-')) { negative = *first++ == '-'; }
+            }
+            // from_chars does not accept a '+'
+            else if (first != last and *first == '+') { first++; }
+            // only one sign is allowed
+            if (first != s.data() and first != last and (*first == '+' or *first == '-')) { return std::errc::invalid_argument; }
+
+            T parsed;
+            std::from_chars_result result;
+            if constexpr (std::floating_point<T>) {
+                // from_chars does not accept the 0x prefix
+                if (last - first > 2 and first[0] == '0' and (first[1] == 'x' or first[1] == 'X')) {
+                    first += 2;
+                    // prevent "0xinf" or "0x-1"
+                    if (!(std::isxdigit(static_cast<unsigned char>(*first)) or *first == '.')) { return std::errc::invalid_argument; }
+                    result = std::from_chars(first, last, parsed, std::chars_format::hex);
+                }
+                else {
+                    result = std::from_chars(first, last, parsed);
+                }
+            }
+            else {
+                result = std::from_chars(first, last, parsed);
+            }
+            if (result.ec != std::errc()) { return result.ec; }
+            if (result.ptr != last) { return std::errc::invalid_argument; }
+            value = negative ? -parsed : parsed;
+            return std::errc();
+        }
+    }
+
+
+    template<util::GetTypeFromStringImplemented T>
+    T fromString(std::string_view s) {
+        T value;
+        std::errc ec = tryFromString(s, value);
+        if (ec == std::errc::result_out_of_range) {
+            throw std::out_of_range("fromString: '" + std::string(s) + "' is out of range");
+        }
+        else if (ec != std::errc()) {
+            throw std::invalid_argument("fromString: '" + std::string(s) + "' is not a valid number");
+        }
+        return value;
+    }
+}  // namespace gz
+
 /**
  * @file
  * @brief Contains functions to construct types from string
- * @todo Make these functions usable with std::string_view
  */
@@ -0,0 +1,172 @@
+#include "string_pool.hpp"
+
+#include "../exceptions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace gz::util {
+
+namespace {
+    /// Size of the blocks the strings are stored in, longer strings get their own block
+    constexpr size_t ARENA_BLOCK_SIZE = 1 << 16;
+    constexpr size_t MIN_TABLE_CAPACITY = 64;
+}
+
+
+/**
+ * @brief Open addressing hash table with linear probing
+ * @details Slots are only set once, from nullptr to an entry, so they can be read without a lock.
+ */
+struct StringPool::Table {
+    Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<const Entry*>[capacity]) {
+        for (size_t i = 0; i < capacity; i++) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    size_t capacity() const { return mask + 1; }
+    /// Must be called with the mutex locked
+    void insert(const Entry* entry) {
+        size_t i = entry->hash & mask;
+        while (slots[i].load(std::memory_order_relaxed) != nullptr) {
+            i = (i + 1) & mask;
+        }
+        slots[i].store(entry, std::memory_order_release);
+    }
+
+    size_t mask;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    /// Number of entries, only used by the writer
+    size_t size = 0;
+};
+
+
+StringPool::StringPool() : count(1) {
+    tables.push_back(std::make_unique<Table>(MIN_TABLE_CAPACITY));
+    table.store(tables.back().get(), std::memory_order_release);
+    for (auto& segment : idSegments) {
+        segment.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+
+StringPool::~StringPool() {
+    for (auto& segment : idSegments) {
+        delete[] segment.load(std::memory_order_relaxed);
+    }
+}
+
+
+const StringPool::Entry* StringPool::findEntry(std::string_view s, size_t hash) const {
+    const Table* t = table.load(std::memory_order_acquire);
+    for (size_t i = hash & t->mask; ; i = (i + 1) & t->mask) {
+        const Entry* entry = t->slots[i].load(std::memory_order_acquire);
+        if (entry == nullptr) { return nullptr; }
+        if (entry->hash == hash and entry->size == s.size() and std::memcmp(entry->data(), s.data(), s.size()) == 0) {
+            return entry;
+        }
+    }
+}
+
+
+const StringPool::Entry* StringPool::createEntry(std::string_view s, size_t hash) {
+    static_assert(alignof(Entry) <= alignof(std::max_align_t));
+    // keep the next entry aligned
+    const size_t entrySize = (sizeof(Entry) + s.size() + 1 + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+    if (entrySize > arenaLeft) {
+        size_t blockSize = std::max(entrySize, ARENA_BLOCK_SIZE);
+        arenaBlocks.emplace_back(new std::byte[blockSize]);
+        arenaPos = arenaBlocks.back().get();
+        arenaLeft = blockSize;
+    }
+    Entry* entry = new (arenaPos) Entry{ hash, count.load(std::memory_order_relaxed), static_cast<uint32_t>(s.size()) };
+    char* data = reinterpret_cast<char*>(entry + 1);
+    std::memcpy(data, s.data(), s.size());
+    data[s.size()] = '\0';
+    arenaPos += entrySize;
+    arenaLeft -= entrySize;
+    return entry;
+}
+
+
+void StringPool::insertId(const Entry* entry) {
+    // segment i holds the ids [SIZE * (2^i - 1), SIZE * (2^(i+1) - 1))
+    const size_t segment = static_cast<size_t>(std::bit_width(entry->id / ID_SEGMENT_SIZE + 1)) - 1;
+    const Entry** entries = idSegments[segment].load(std::memory_order_relaxed);
+    if (entries == nullptr) {
+        entries = new const Entry*[ID_SEGMENT_SIZE << segment];
+        idSegments[segment].store(entries, std::memory_order_release);
+    }
+    entries[entry->id - ID_SEGMENT_SIZE * ((size_t(1) << segment) - 1)] = entry;
+}
+
+
+InternedString StringPool::intern(std::string_view s) {
+    if (s.empty()) { return InternedString(); }
+    // the size is stored as uint32_t
+    if (s.size() > UINT32_MAX) {
+        throw InvalidArgument("String is too long: " + std::to_string(s.size()) + " bytes", "StringPool::intern");
+    }
+    const size_t hash = std::hash<std::string_view>()(s);
+    if (const Entry* entry = findEntry(s, hash)) {
+        return InternedString(entry);
+    }
+
+    std::lock_guard lock(mtx);
+    // might have been inserted while waiting for the lock
+    if (const Entry* entry = findEntry(s, hash)) {
+        return InternedString(entry);
+    }
+    if (count.load(std::memory_order_relaxed) == UINT32_MAX) {
+        throw InvalidArgument("StringPool is full", "StringPool::intern");
+    }
+
+    Table* t = tables.back().get();
+    // grow at a load factor of 1/2
+    if (2 * (t->size + 1) > t->capacity()) {
+        tables.push_back(std::make_unique<Table>(2 * t->capacity()));
+        Table* newTable = tables.back().get();
+        for (size_t i = 0; i < t->capacity(); i++) {
+            if (const Entry* entry = t->slots[i].load(std::memory_order_relaxed)) {
+                newTable->insert(entry);
+            }
+        }
+        newTable->size = t->size;
+        t = newTable;
+        // readers of the old table will still find all strings that were in it
+        table.store(t, std::memory_order_release);
+    }
+
+    const Entry* entry = createEntry(s, hash);
+    insertId(entry);
+    t->insert(entry);
+    t->size++;
+    // publish the id after the entry can be found by it
+    count.fetch_add(1, std::memory_order_release);
+    return InternedString(entry);
+}
+
+
+std::optional<InternedString> StringPool::find(std::string_view s) const {
+    if (s.empty()) { return InternedString(); }
+    if (const Entry* entry = findEntry(s, std::hash<std::string_view>()(s))) {
+        return InternedString(entry);
+    }
+    return std::nullopt;
+}
+
+
+InternedString StringPool::at(uint32_t id) const {
+    if (id >= size()) {
+        throw InvalidArgument("Invalid id: " + std::to_string(id) + ", pool only has " + std::to_string(size()) + " strings", "StringPool::at");
+    }
+    if (id == 0) { return InternedString(); }
+    const size_t segment = static_cast<size_t>(std::bit_width(id / ID_SEGMENT_SIZE + 1)) - 1;
+    const Entry* const* entries = idSegments[segment].load(std::memory_order_acquire);
+    return InternedString(entries[id - ID_SEGMENT_SIZE * ((size_t(1) << segment) - 1)]);
+}
+
+} // namespace gz::util
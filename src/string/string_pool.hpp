@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace gz::util {
+    class StringPool;
+
+    /**
+     * @brief A string that was interned in a StringPool
+     * @details
+     *  Only holds a pointer to the string in the pool, so it is as cheap to copy as a pointer.
+     *  The hash of the string is computed once when it is interned, and two InternedStrings
+     *  from the same pool are equal if and only if they point to the same string, so comparing them is O(1).
+     *
+     *  hash() returns the same value as std::hash<std::string_view>, so an InternedString can also be used
+     *  to look up elements in an unordered_string_map without hashing the string again:
+     *  @code
+     *   gz::util::StringPool pool;
+     *   gz::util::InternedString key = pool.intern("window.width");
+     *   gz::util::unordered_string_map<int> settings = { { "window.width", 800 } };
+     *   int width = settings.find(key)->second;
+     *  @endcode
+     *  With std::unordered_map<InternedString, T>, both hashing and key comparisons are O(1).
+     *
+     * @note
+     *  InternedStrings from different pools are never equal, even if they hold the same string.
+     *  They are valid as long as their pool exists.
+     */
+    class InternedString {
+        public:
+            /// The empty string, which is the same in every pool
+            InternedString() = default;
+
+            std::string_view view() const { return entry == nullptr ? std::string_view() : std::string_view(entry->data(), entry->size); }
+            operator std::string_view() const { return view(); }
+            /// @returns Null terminated string
+            const char* c_str() const { return entry == nullptr ? "" : entry->data(); }
+            size_t size() const { return entry == nullptr ? 0 : entry->size; }
+            bool empty() const { return entry == nullptr; }
+            /**
+             * @brief The id of the string in its pool
+             * @details Ids are given out in ascending order, starting at 1. The empty string has id 0.
+             * @see StringPool::at
+             */
+            uint32_t id() const { return entry == nullptr ? 0 : entry->id; }
+            /// Same as std::hash<std::string_view>()(view()), but precomputed
+            size_t hash() const { return entry == nullptr ? std::hash<std::string_view>()(std::string_view()) : entry->hash; }
+
+            bool operator==(const InternedString& other) const { return entry == other.entry; }
+            friend bool operator==(const InternedString& s, std::string_view sv) { return s.view() == sv; }
+
+        private:
+            friend StringPool;
+            /// Header of a string in the pool, the null terminated string follows directly after it
+            struct Entry {
+                size_t hash;
+                uint32_t id;
+                uint32_t size;
+                const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+            };
+            explicit InternedString(const Entry* entry) : entry(entry) {}
+            const Entry* entry = nullptr;
+    };
+
+
+    /**
+     * @brief A thread safe pool of unique strings
+     * @details
+     *  intern() copies a string into the pool once and returns an InternedString that points to it,
+     *  interning the same string again returns the same InternedString.
+     *  This saves memory when the same strings (eg. keys of a configuration) are stored in many places,
+     *  and makes comparisons and hashing O(1).
+     *
+     *  The strings are stored in large blocks and are never moved or freed until the pool is destroyed,
+     *  so InternedString::view() and InternedString::c_str() remain valid for the lifetime of the pool.
+     *
+     *  @subsection string_pool_concurrency Concurrency
+     *   All member functions can be called from multiple threads.
+     *   Looking up a string that is already in the pool (intern(), find()) and at() do not lock a mutex:
+     *   They read an open addressing hash table whose slots are only ever set once.
+     *   Only inserting a new string locks a mutex.
+     *   When the table grows, the old table is kept alive until the pool is destroyed, since readers might still use it.
+     *   This at most doubles the memory used by the tables.
+     */
+    class StringPool {
+        public:
+            StringPool();
+            ~StringPool();
+            StringPool(const StringPool&) = delete;
+            StringPool& operator=(const StringPool&) = delete;
+
+            /**
+             * @brief Get the InternedString for s, and insert s into the pool if it is not already in there
+             * @throws InvalidArgument if s is longer than UINT32_MAX bytes or the pool already holds UINT32_MAX strings
+             */
+            InternedString intern(std::string_view s);
+            /**
+             * @brief Get the InternedString for s, if s is in the pool
+             */
+            std::optional<InternedString> find(std::string_view s) const;
+            /**
+             * @brief Get the InternedString with id
+             * @throws InvalidArgument if id >= size()
+             */
+            InternedString at(uint32_t id) const;
+            /// @returns Number of strings in the pool, including the empty string
+            size_t size() const { return count.load(std::memory_order_acquire); }
+
+        private:
+            using Entry = InternedString::Entry;
+            struct Table;
+
+            /// @returns The entry for s or nullptr
+            const Entry* findEntry(std::string_view s, size_t hash) const;
+            /// Copy s into the arena, must be called with the mutex locked
+            const Entry* createEntry(std::string_view s, size_t hash);
+            /// Make the entry findable by its id, must be called with the mutex locked
+            void insertId(const Entry* entry);
+
+            std::mutex mtx;
+            /// The table used for lookups
+            std::atomic<Table*> table;
+            /// The current and all previous tables
+            std::vector<std::unique_ptr<Table>> tables;
+
+            /// Segment i holds ID_SEGMENT_SIZE << i entries
+            static constexpr size_t ID_SEGMENT_SIZE = 256;
+            static constexpr size_t ID_SEGMENT_COUNT = 24;
+            std::array<std::atomic<const Entry**>, ID_SEGMENT_COUNT> idSegments;
+            std::atomic<uint32_t> count;
+
+            std::vector<std::unique_ptr<std::byte[]>> arenaBlocks;
+            std::byte* arenaPos = nullptr;
+            size_t arenaLeft = 0;
+    };
+} // namespace gz::util
+
+
+/// The precomputed hash of an InternedString
+template<>
+struct std::hash<gz::util::InternedString> {
+    size_t operator()(const gz::util::InternedString& s) const { return s.hash(); }
+};
+
+/**
+ * @file
+ * @brief Contains a pool for interning strings
+ */
@@ -2,9 +2,13 @@
 
 #include "../concepts.hpp"
 
+#include <charconv>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 #include <ranges>
+#include <type_traits>
 
 #define GZ_UTIL_STRING_CONCEPTS
 
@@ -14,6 +18,12 @@
 template<gz::util::False T>
 std::string toString(const T& s);
 
+/**
+ * @brief Declaration of toStringAppend in global namespace, so that concepts can use it.
+ */
+template<gz::util::False T>
+void toStringAppend(std::string& out, const T& s);
+
 namespace gz::util {
     /**
      * @name 1) concepts for elementary types and custom toStrings()
@@ -57,7 +67,19 @@ namespace gz::util {
             !HasToStringMember2<T> &&
             requires(const T& t) { { std::to_string(t) } -> Stringy; };
 
-        /// toString function overload exists in global namespace and returns std::string
+        /// toStringAppend function overload exists in global namespace
+        template<typename T>
+        concept AppendsToStringGlobal = 
+            !Stringy<T> && 
+            !CanConstructString<T> &&
+            !HasToStringMember<T> && 
+            !HasToStringMember2<T> &&
+            !WorksWithStdToString<T> &&
+            requires(std::string& out, const T& t) { 
+                ::toStringAppend(out, t); 
+            };
+
+        /// toString function overload exists in global namespace and returns std::string, std::string_view or const char*
         template<typename T>
         concept ConvertibleToStringGlobal = 
             !Stringy<T> && 
@@ -65,8 +87,9 @@ namespace gz::util {
             !HasToStringMember<T> && 
             !HasToStringMember2<T> &&
             !WorksWithStdToString<T> &&
+            !AppendsToStringGlobal<T> &&
             requires(const T& t) { 
-                { ::toString(t) } -> std::same_as<std::string>; 
+                { ::toString(t) } -> Stringy; 
             };
 
         template<typename T>
@@ -76,6 +99,7 @@ namespace gz::util {
             HasToStringMember<T> ||
             HasToStringMember2<T> ||
             WorksWithStdToString<T> ||
+            AppendsToStringGlobal<T> ||
             ConvertibleToStringGlobal<T>;
 
 #ifndef GZ_TO_STRING_NO_VECTORS
@@ -152,8 +176,19 @@ namespace gz {
      * @name 1) Converting a type to string
      * @details
      *  All toString functions for types that satisfy util::ToStringBasicNoPtr or util::PtrToToStringBasicType
+     *
+     *  For every toString(t) there is a toStringAppend(out, t) that appends the string to out instead of returning a new string.
+     *  toString(t) simply calls toStringAppend on an empty string.
+     *  Nested types (containers, vectors, pairs) append their elements directly, so they only need a single string.
      * @{
      */
+        /**
+         * @brief Append the string
+         */
+        template<util::Stringy T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += t;
+        }
         /**
          * @brief Return the string
          * @returns static_cast<std::string>(t)
@@ -163,6 +198,18 @@ namespace gz {
             return static_cast<std::string>(t);
         }
 
+        /**
+         * @brief Append a string constructed from a string like-type
+         */
+        template<util::CanConstructString T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            if constexpr (std::convertible_to<const T&, std::string_view>) {
+                out += std::string_view(t);
+            }
+            else {
+                out += std::string(t);
+            }
+        }
         /**
          * @brief Construct a string from a string like-type
          * @returns std::string(t)
@@ -172,6 +219,14 @@ namespace gz {
             return std::string(t);
         }
 
+        /**
+         * @overload
+         * @brief Append t.toString()
+         */
+        template<util::HasToStringMember T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += t.toString();
+        }
         /**
          * @overload
          * @brief Construct a string from a type having a toString() const member function
@@ -182,6 +237,14 @@ namespace gz {
             return t.toString();
         }
 
+        /**
+         * @overload
+         * @brief Append t.to_string()
+         */
+        template<util::HasToStringMember2 T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += t.to_string();
+        }
         /**
          * @overload
          * @brief Construct a string from a type having a to_string() const member function
@@ -192,16 +255,87 @@ namespace gz {
             return t.to_string();
         }
 
+        /**
+         * @overload
+         * @brief Append a floating point number with std::to_chars
+         * @param fmt Format, see std::chars_format
+         * @param precision Number of digits (after the decimal point for fixed/scientific), or -1 for the shortest representation that round-trips
+         */
+        template<std::floating_point T>
+        void toStringAppend(std::string& out, const T& t, std::chars_format fmt, int precision=-1) {
+            const size_t begin = out.size();
+            // enough for the shortest representation, retry with a larger buffer for long fixed output
+            size_t space = 64;
+            while (true) {
+                out.resize(begin + space);
+                char* first = out.data() + begin;
+                char* last = out.data() + out.size();
+                auto result = precision < 0 ? std::to_chars(first, last, t, fmt) : std::to_chars(first, last, t, fmt, precision);
+                if (result.ec == std::errc()) {
+                    out.resize(static_cast<size_t>(result.ptr - out.data()));
+                    return;
+                }
+                space *= 4;
+            }
+        }
+        /**
+         * @overload
+         * @brief Construct a string from a floating point number with std::to_chars
+         * @details See toStringAppend(std::string&, const T&, std::chars_format, int)
+         */
+        template<std::floating_point T>
+        inline std::string toString(const T& t, std::chars_format fmt, int precision=-1) {
+            std::string s;
+            toStringAppend(s, t, fmt, precision);
+            return s;
+        }
+
+        /**
+         * @overload
+         * @brief Append a number
+         * @details
+         *  Numbers are written with std::to_chars, so that no temporary string is needed.
+         *  Integers are the same as std::to_string(t).
+         *  Floating point numbers use the shortest representation that round-trips (eg. 0.1, 1e-09),
+         *  unlike std::to_string which always uses 6 decimals.
+         */
+        template<util::WorksWithStdToString T>
+        inline void toStringAppend(std::string& out, const T& t) requires (!std::same_as<T, bool>) {
+            if constexpr (std::integral<T>) {
+                // enough for 64 bit numbers with sign
+                char buffer[24];
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), t);
+                out.append(buffer, result.ptr);
+            }
+            else if constexpr (std::floating_point<T>) {
+                // enough for the shortest representation of any floating point type
+                char buffer[64];
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), t);
+                out.append(buffer, result.ptr);
+            }
+            else {
+                out += std::to_string(t);
+            }
+        }
         /**
          * @overload
          * @brief Construct a string from a number
-         * @returns std::to_string(t)
+         * @details See toStringAppend()
          */
         template<util::WorksWithStdToString T>
         inline std::string toString(const T& t) requires (!std::same_as<T, bool>) {
-            return std::to_string(t);
+            std::string s;
+            toStringAppend(s, t);
+            return s;
         }
 
+        /**
+         * @brief Append "true" or "false"
+         */
+        template<std::same_as<bool> T>
+        inline void toStringAppend(std::string& out, const T& b) {
+            out += b ? "true" : "false";
+        }
         /**
          * @brief Construct a string from a boolean
          * @details
@@ -213,16 +347,55 @@ namespace gz {
             return b ? "true" : "false";
         }
 
+        /**
+         * @overload
+         * @brief Append using a toStringAppend that is declared in global namespace
+         */
+        template<util::AppendsToStringGlobal T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            ::toStringAppend(out, t);
+        }
+        /**
+         * @overload
+         * @brief Construct a string from a type that has toStringAppend declared in global namespace
+         */
+        template<util::AppendsToStringGlobal T>
+        inline std::string toString(const T& t) {
+            std::string s;
+            ::toStringAppend(s, t);
+            return s;
+        }
+
+        /**
+         * @overload
+         * @brief Append using a toString that is declared in global namespace
+         */
+        template<util::ConvertibleToStringGlobal T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += ::toString(t);
+        }
         /**
          * @overload
          * @brief Construct a string from a type that has toString declared in global namespace
          */
         template<util::ConvertibleToStringGlobal T>
         inline std::string toString(const T& t) {
-            return ::toString(t);
+            return std::string(::toString(t));
         }
 
 #ifndef GZ_TO_STRING_NO_VECTORS
+        /**
+         * @overload
+         * @brief Append a vector with x, y members
+         */
+        template<util::Vector2ConvertibleToString T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += "( ";
+            toStringAppend(out, t.x);
+            out += ", ";
+            toStringAppend(out, t.y);
+            out += " )";
+        }
         /**
          * @overload
          * @brief Construct a string from a vector with x, y members
@@ -230,12 +403,25 @@ namespace gz {
          */
         template<util::Vector2ConvertibleToString T>
         inline std::string toString(const T& t) {
-            std::string s = "( ";
-            s += toString(t.x) + ", ";
-            s += toString(t.y) + " )";
+            std::string s;
+            toStringAppend(s, t);
             return s;
         }
 
+        /**
+         * @overload
+         * @brief Append a vector with x, y, z members
+         */
+        template<util::Vector3ConvertibleToString T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += "( ";
+            toStringAppend(out, t.x);
+            out += ", ";
+            toStringAppend(out, t.y);
+            out += ", ";
+            toStringAppend(out, t.z);
+            out += " )";
+        }
         /**
          * @overload
          * @brief Construct a string from a vector with x, y members
@@ -243,13 +429,27 @@ namespace gz {
          */
         template<util::Vector3ConvertibleToString T>
         inline std::string toString(const T& t) {
-            std::string s = "( ";
-            s += toString(t.x) + ", ";
-            s += toString(t.y) + ", ";
-            s += toString(t.z) + " )";
+            std::string s;
+            toStringAppend(s, t);
             return s;
         }
 
+        /**
+         * @overload
+         * @brief Append a vector with x, y, z, w members
+         */
+        template<util::Vector4ConvertibleToString T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += "( ";
+            toStringAppend(out, t.x);
+            out += ", ";
+            toStringAppend(out, t.y);
+            out += ", ";
+            toStringAppend(out, t.z);
+            out += ", ";
+            toStringAppend(out, t.w);
+            out += " )";
+        }
         /**
          * @overload
          * @brief Construct a string from a vector with x, y, z, w members
@@ -257,14 +457,23 @@ namespace gz {
          */
         template<util::Vector4ConvertibleToString T>
         inline std::string toString(const T& t) {
-            std::string s = "( ";
-            s += toString(t.x) + ", ";
-            s += toString(t.y) + ", ";
-            s += toString(t.z) + ", ";
-            s += toString(t.w) + " )";
+            std::string s;
+            toStringAppend(s, t);
             return s;
         }
 
+        /**
+         * @overload
+         * @brief Append a type having width and height members
+         */
+        template<util::Extent2DConvertibleToString T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += "( ";
+            toStringAppend(out, t.width);
+            out += ", ";
+            toStringAppend(out, t.height);
+            out += " ) ";
+        }
         /**
          * @overload
          * @brief Construct a string from a type having width and height members
@@ -272,12 +481,25 @@ namespace gz {
          */
         template<util::Extent2DConvertibleToString T>
         inline std::string toString(const T& t) {
-            std::string s = "( ";
-            s += toString(t.width) + ", ";
-            s += toString(t.height) + " ) ";
+            std::string s;
+            toStringAppend(s, t);
             return s;
         }
 
+        /**
+         * @overload
+         * @brief Append a type having width, height and depth members
+         */
+        template<util::Extent3DConvertibleToString T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            out += "( ";
+            toStringAppend(out, t.width);
+            out += ", ";
+            toStringAppend(out, t.height);
+            out += ", ";
+            toStringAppend(out, t.depth);
+            out += " ) ";
+        }
         /**
          * @overload
          * @brief Construct a string from a type having width and height members
@@ -285,14 +507,20 @@ namespace gz {
          */
         template<util::Extent3DConvertibleToString T>
         inline std::string toString(const T& t) {
-            std::string s = "( ";
-            s += toString(t.width) + ", ";
-            s += toString(t.height) + ", ";
-            s += toString(t.depth) + " ) ";
+            std::string s;
+            toStringAppend(s, t);
             return s;
         }
 #endif
 
+        /**
+         * @overload
+         * @brief Append the element the pointer points at
+         */
+        template<util::PtrToToStringBasicOrVector T>
+        inline void toStringAppend(std::string& out, const T& t) {
+            toStringAppend(out, *t);
+        }
         /**
          * @overload
          * @brief Construct a string from the element the pointer points at
@@ -303,6 +531,13 @@ namespace gz {
             return toString(*t);        
         }
 
+        /**
+         * @overload
+         * @brief Append the address of the void*
+         */
+        inline void toStringAppend(std::string& out, const void* const voidPtr) {
+            toStringAppend(out, reinterpret_cast<uint64_t>(voidPtr));
+        }
         /**
          * @overload
          * @brief Construct a string from the address of the void*
@@ -311,6 +546,7 @@ namespace gz {
         inline std::string toString(const void* const voidPtr) {
             return toString(reinterpret_cast<uint64_t>(voidPtr));        
         }
+    /// @}
 }  // namespace gz
 
 
@@ -352,6 +588,39 @@ namespace gz::util {
         concept _ContainerTypeConvertibleToString = PairConvertibleToString<T> || ForwardRangeConvertibleToString<T> || MapConvertibleToString<T>;
     /// @}
 
+    /// Number types for which toStringAppendParallel() is implemented
+    template<typename T>
+    concept _FormatsInParallel =
+        std::same_as<T, int> or
+        std::same_as<T, long> or
+        std::same_as<T, long long> or
+        std::same_as<T, unsigned int> or
+        std::same_as<T, unsigned long> or
+        std::same_as<T, unsigned long long> or
+        std::same_as<T, float> or
+        std::same_as<T, double> or
+        std::same_as<T, long double>;
+
+    /// Contiguous ranges of numbers that toStringParallel() accepts
+    template<typename T>
+    concept NumberRangeFormattableInParallel = std::ranges::contiguous_range<T> and std::ranges::sized_range<T> and
+        _FormatsInParallel<std::ranges::range_value_t<T>>;
+
+    /// toStringAppendParallel() starts at most one thread per TO_STRING_PARALLEL_MIN_SIZE / 2 numbers
+    constexpr size_t TO_STRING_PARALLEL_MIN_SIZE = 1 << 16;
+
+    /**
+     * @brief Append `[ x1, x2, ... ]`, formatting chunks of the numbers on multiple threads
+     * @details
+     *  The numbers are split into equally sized chunks that are formatted into separate buffers,
+     *  which are then appended to out after a single reservation of the exact total size.
+     *  Each thread formats at least TO_STRING_PARALLEL_MIN_SIZE / 2 numbers, so small ranges are formatted on the calling thread.
+     *  The output is the same as the sequential toStringAppend() for forward ranges.
+     * @param threadCount Maximum number of threads, 0 = std::thread::hardware_concurrency()
+     */
+    template<_FormatsInParallel T>
+    void toStringAppendParallel(std::string& out, std::span<const T> numbers, unsigned int threadCount);
+
 }  // namespace gz::util
 
 
@@ -363,6 +632,41 @@ namespace gz {
      *  All toString functions for types that satisfy util::_ContainerTypeConvertibleToString
      * @{
      */
+        template<util::ForwardRangeConvertibleToString T>
+        void toStringAppend(std::string& out, const T& t);
+        template<util::PairConvertibleToString T>
+        void toStringAppend(std::string& out, const T& t);
+        template<util::MapConvertibleToString T>
+        void toStringAppend(std::string& out, const T& t);
+
+        /**
+         * @brief Append any type that is convertible to string, used for the elements of containers
+         * @details Uses toString() for types without toStringAppend(), eg. when a toString() overload was added to namespace gz.
+         */
+        template<typename T>
+        inline void _toStringAppendAny(std::string& out, const T& t) {
+            if constexpr (requires { toStringAppend(out, t); }) {
+                toStringAppend(out, t);
+            }
+            else {
+                out += toString(t);
+            }
+        }
+
+        /**
+         * @overload
+         * @brief Append a forward range
+         * @details Large contiguous ranges of numbers can be formatted on multiple threads with toStringParallel()
+         */
+        template<util::ForwardRangeConvertibleToString T>
+        void toStringAppend(std::string& out, const T& t) {
+            out += "[ ";
+            for (auto it = t.begin(); it != t.end(); it++) {
+                if (it != t.begin()) { out += ", "; }
+                _toStringAppendAny(out, *it);
+            }
+            out += " ]";
+        }
         /**
          * @overload
          * @brief Construct a string from a forward range
@@ -370,17 +674,39 @@ namespace gz {
          */
         template<util::ForwardRangeConvertibleToString T>
         std::string toString(const T& t) {
-            std::string s = "[ ";
-            for (auto it = t.begin(); it != t.end(); it++) {
-                s += toString(*it) + ", ";
-            }
-            if (s.size() > 2) {
-                s.erase(s.size() - 2);
-            }
-            s += " ]";
+            std::string s;
+            toStringAppend(s, t);
+            return s;
+        }
+
+        /**
+         * @brief Construct a string from a contiguous range of numbers, formatting chunks of the numbers on multiple threads
+         * @details
+         *  Same output as toString(), but faster for large ranges, see util::toStringAppendParallel().
+         *  toString() never starts threads, so this has to be called explicitly.
+         * @param threadCount Maximum number of threads, 0 = std::thread::hardware_concurrency()
+         * @returns [ x1, x2, ... ]
+         */
+        template<util::NumberRangeFormattableInParallel T>
+        std::string toStringParallel(const T& t, unsigned int threadCount) {
+            using Element = std::ranges::range_value_t<T>;
+            std::string s;
+            util::toStringAppendParallel(s, std::span<const Element>(std::ranges::data(t), std::ranges::size(t)), threadCount);
             return s;
         }
 
+        /**
+         * @overload
+         * @brief Append a pair
+         */
+        template<util::PairConvertibleToString T>
+        void toStringAppend(std::string& out, const T& t) {
+            out += "( ";
+            _toStringAppendAny(out, t.first);
+            out += ", ";
+            _toStringAppendAny(out, t.second);
+            out += " )";
+        }
         /**
          * @overload
          * @brief Construct a string from a pair
@@ -388,9 +714,28 @@ namespace gz {
          */
         template<util::PairConvertibleToString T>
         inline std::string toString(const T& t) {
-            return "( " + toString(t.first) + ", " + toString(t.second) + " )";
+            std::string s;
+            toStringAppend(s, t);
+            return s;
         }
 
+        /**
+         * @overload
+         * @brief Append a forward range holding a pair, eg a map
+         */
+        template<util::MapConvertibleToString T>
+        void toStringAppend(std::string& out, const T& t) {
+            out += "{ ";
+            bool first = true;
+            for (const auto& [k, v] : t) {
+                if (!first) { out += ", "; }
+                first = false;
+                _toStringAppendAny(out, k);
+                out += ": ";
+                _toStringAppendAny(out, v);
+            }
+            out += " }";
+        }
         /**
          * @overload
          * @brief Construct a string from a forward range holding a pair, eg a map
@@ -398,15 +743,8 @@ namespace gz {
          */
         template<util::MapConvertibleToString T>
         std::string toString(const T& t) {
-            std::string s = "{ ";
-            for (const auto& [k, v] : t) {
-                s += toString(k) + ": ";
-                s += toString(v) + ", ";
-            }
-            if (s.size() > 2) {
-                s.erase(s.size() - 2);
-            }
-            s += " }";
+            std::string s;
+            toStringAppend(s, t);
             return s;
         }
     /// @}
@@ -419,6 +757,16 @@ namespace gz {
         requires (const T& t) {
             { gz::toString(t) } -> std::same_as<std::string>;
         };
+
+    /**
+     * @brief Any type where gz::toStringAppend(out, t) exists
+     * @details This is the case for every type that satisfies ConvertibleToString
+     */  
+    template<typename T>
+    concept AppendableToString =
+        requires (std::string& out, const T& t) {
+            gz::toStringAppend(out, t);
+        };
 }  // namespace gz
 
 /**
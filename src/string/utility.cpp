@@ -1,8 +1,17 @@
 #include "utility.hpp"
 
+#include <cstring>
 #include <sstream>
 #include <iostream>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#include <immintrin.h>
+#define GZ_UTIL_AVX2_DISPATCH
+#endif
+
 
 namespace gz::util {
 
@@ -31,6 +40,9 @@ std::vector<std::string> splitStringInVector(std::string& s, char separator) {
 
 template<SplitStringInVectorImplemented T>
 std::vector<T> splitStringInVector(const std::string_view& s, const std::string& separator, bool skipEmptyStrings) {
+    if (separator.size() == 1) {
+        return splitStringInVector<T>(s, separator.front(), skipEmptyStrings);
+    }
     std::vector<T> v;
 
     std::string::size_type posStart = 0;
@@ -56,4 +68,117 @@ std::vector<T> splitStringInVector(const std::string_view& s, const std::string&
 template std::vector<std::string_view> splitStringInVector<std::string_view>(const std::string_view&, const std::string&, bool);
 template std::vector<std::string> splitStringInVector<std::string>(const std::string_view&, const std::string&, bool);
 
+
+//
+// SINGLE CHAR SEPARATOR
+//
+namespace {
+    /// Call f with the index of every c in s[begin, size)
+    template<typename F>
+    inline void forEachCharScalar(const char* s, size_t begin, size_t size, char c, F& f) {
+        while (begin < size) {
+            const char* found = static_cast<const char*>(std::memchr(s + begin, c, size - begin));
+            if (found == nullptr) { return; }
+            size_t i = static_cast<size_t>(found - s);
+            f(i);
+            begin = i + 1;
+        }
+    }
+
+#ifdef __SSE2__
+    template<typename F>
+    void forEachCharSSE2(const char* s, size_t size, char c, F& f) {
+        const __m128i needle = _mm_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, needle)));
+            while (mask != 0) {
+                f(i + static_cast<size_t>(__builtin_ctz(mask)));
+                mask &= mask - 1;
+            }
+        }
+        forEachCharScalar(s, i, size, c, f);
+    }
+#endif
+
+#ifdef GZ_UTIL_AVX2_DISPATCH
+    template<typename F>
+    __attribute__((target("avx2")))
+    void forEachCharAVX2(const char* s, size_t size, char c, F& f) {
+        const __m256i needle = _mm256_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, needle)));
+            while (mask != 0) {
+                f(i + static_cast<size_t>(__builtin_ctz(mask)));
+                mask &= mask - 1;
+            }
+        }
+        forEachCharScalar(s, i, size, c, f);
+    }
+
+    bool cpuHasAVX2() {
+        static const bool hasAVX2 = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return hasAVX2;
+    }
+#endif
+
+    /// Call f with the index of every c in s, in ascending order
+    template<typename F>
+    void forEachChar(const std::string_view& s, char c, F&& f) {
+#ifdef GZ_UTIL_AVX2_DISPATCH
+        if (cpuHasAVX2()) {
+            forEachCharAVX2(s.data(), s.size(), c, f);
+            return;
+        }
+#endif
+#ifdef __SSE2__
+        forEachCharSSE2(s.data(), s.size(), c, f);
+#else
+        forEachCharScalar(s.data(), 0, s.size(), c, f);
+#endif
+    }
+}
+
+
+void findAll(const std::string_view& s, char c, std::vector<size_t>& positions) {
+    positions.clear();
+    forEachChar(s, c, [&positions](size_t i) { positions.push_back(i); });
+}
+
+
+template<SplitStringInVectorImplemented T>
+void splitStringInVector(const std::string_view& s, char separator, std::vector<T>& v, bool skipEmptyStrings) {
+    v.clear();
+    size_t posStart = 0;
+    forEachChar(s, separator, [&](size_t posEnd) {
+        if (!(skipEmptyStrings and posStart == posEnd)) {
+            v.emplace_back(T(s.begin() + posStart, s.begin() + posEnd));
+        }
+        posStart = posEnd + 1;
+    });
+    // last element, empty if last char is separator
+    if (!(skipEmptyStrings and posStart == s.size())) {
+        v.emplace_back(T(s.begin() + posStart, s.end()));
+    }
+}
+
+
+template<SplitStringInVectorImplemented T>
+std::vector<T> splitStringInVector(const std::string_view& s, char separator, bool skipEmptyStrings) {
+    std::vector<T> v;
+    splitStringInVector<T>(s, separator, v, skipEmptyStrings);
+    return v;
+}
+
+template std::vector<std::string_view> splitStringInVector<std::string_view>(const std::string_view&, char, bool);
+template std::vector<std::string> splitStringInVector<std::string>(const std::string_view&, char, bool);
+template void splitStringInVector<std::string_view>(const std::string_view&, char, std::vector<std::string_view>&, bool);
+template void splitStringInVector<std::string>(const std::string_view&, char, std::vector<std::string>&, bool);
+
 } // namespace gz::util
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <map>
@@ -30,6 +34,102 @@ namespace gz::util {
      */
     template<SplitStringInVectorImplemented T>
     std::vector<T> splitStringInVector(const std::string_view& s, const std::string& separator, bool skipEmptyStrings=false);
+    /**
+     * @overload
+     * @details
+     *  Same behavior as the variant with a string separator, but faster:
+     *  All separators are found in a single pass using findAll().
+     */
+    template<SplitStringInVectorImplemented T>
+    std::vector<T> splitStringInVector(const std::string_view& s, char separator, bool skipEmptyStrings=false);
+    /**
+     * @overload
+     * @details
+     *  Clears v and fills it with the elements.
+     *  Pass the same vector to subsequent calls to reuse its memory, eg. when splitting every line of a file.
+     */
+    template<SplitStringInVectorImplemented T>
+    void splitStringInVector(const std::string_view& s, char separator, std::vector<T>& v, bool skipEmptyStrings=false);
+
+    /**
+     * @brief Find all occurences of c in s
+     * @details
+     *  Clears positions and fills it with the indices of all occurences of c, in ascending order.
+     *
+     *  s is scanned 32 bytes at a time with AVX2 if the cpu supports it (checked at runtime),
+     *  else 16 bytes at a time with SSE2. On other architectures, memchr is used.
+     */
+    void findAll(const std::string_view& s, char c, std::vector<size_t>& positions);
+
+    /**
+     * @brief A lazy view of the elements of a string split at a separator
+     * @details
+     *  Yields the same elements as splitStringInVector<std::string_view>, but finds them one at a time
+     *  while iterating, so no vector is allocated and iteration can stop early.
+     *
+     *  The view satisfies std::ranges::forward_range and std::ranges::borrowed_range,
+     *  so it can be composed with the standard range adaptors:
+     *  @code
+     *   for (int i : gz::util::split_view(line, ',', true)
+     *                | std::views::take(3)
+     *                | std::views::transform([](std::string_view sv) { return gz::fromString<int>(sv); })) {
+     *       ...
+     *   }
+     *  @endcode
+     *  The separator can be a char or a string, which must not be empty.
+     * @note
+     *  The elements reference the original string, so it must not be changed or destroyed
+     *  as long as the view or the elements are used!
+     */
+    template<typename Separator>
+        requires std::same_as<Separator, char> || std::same_as<Separator, std::string_view>
+    class split_view : public std::ranges::view_interface<split_view<Separator>> {
+        public:
+            /// The iterator holds a copy of the string and separator, so it remains valid when the view is destroyed
+            class iterator {
+                public:
+                    using value_type = std::string_view;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::forward_iterator_tag;
+                    using iterator_concept = std::forward_iterator_tag;
+
+                    constexpr iterator() = default;
+                    constexpr std::string_view operator*() const { return s.substr(tokenBegin, tokenEnd - tokenBegin); }
+                    constexpr iterator& operator++();
+                    constexpr iterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+                    constexpr bool operator==(const iterator& other) const { return tokenBegin == other.tokenBegin; }
+                private:
+                    friend split_view;
+                    constexpr iterator(std::string_view s, Separator separator, bool skipEmptyStrings, size_t pos)
+                        : s(s), separator(separator), skipEmptyStrings(skipEmptyStrings) { findToken(pos); }
+                    /// Find the next element that starts at or after pos
+                    constexpr void findToken(size_t pos);
+                    constexpr size_t separatorSize() const {
+                        if constexpr (std::same_as<Separator, char>) { return 1; }
+                        else { return separator.size(); }
+                    }
+                    std::string_view s;
+                    Separator separator{};
+                    bool skipEmptyStrings = false;
+                    /// npos if this is the end iterator
+                    size_t tokenBegin = std::string_view::npos;
+                    size_t tokenEnd = std::string_view::npos;
+            };
+
+            constexpr split_view() = default;
+            constexpr split_view(std::string_view s, Separator separator, bool skipEmptyStrings=false)
+                : s(s), separator(separator), skipEmptyStrings(skipEmptyStrings) {}
+
+            constexpr iterator begin() const { return iterator(s, separator, skipEmptyStrings, 0); }
+            constexpr iterator end() const { return iterator(); }
+        private:
+            std::string_view s;
+            Separator separator{};
+            bool skipEmptyStrings = false;
+    };
+    split_view(std::string_view, char, bool=false) -> split_view<char>;
+    split_view(std::string_view, std::string_view, bool=false) -> split_view<std::string_view>;
+    split_view(std::string_view, const char*, bool=false) -> split_view<std::string_view>;
 
     /**
      * @name Map with string type as key, works with strings, string_view and char*
@@ -43,6 +143,10 @@ namespace gz::util {
         size_t operator()(const char* str) const        { return hash_type{}(str); }
         size_t operator()(std::string_view str) const   { return hash_type{}(str); }
         size_t operator()(std::string const& str) const { return hash_type{}(str); }
+        /// Strings that store their hash, like InternedString
+        template<typename S>
+            requires requires(const S& s) { { s.hash() } -> std::same_as<size_t>; }
+        size_t operator()(const S& str) const { return str.hash(); }
     };
     /**
      * @brief A unordered_map where you can use string_views to access elements
@@ -62,15 +166,55 @@ namespace gz::util {
     using unordered_string_map = std::unordered_map<std::string, T, util::string_hash, std::equal_to<>>;
     /**
      * @brief same as unordered_string_map, but using std::map instead of std::unordered_map
+     * @details The transparent comparator std::less<> allows lookups with string_views.
      */
     template<typename T>
-    using string_map = std::map<std::string, T, util::string_hash, std::equal_to<>>;
+    using string_map = std::map<std::string, T, std::less<>>;
     /**
      * @}
      */
 
+
+    template<typename Separator>
+        requires std::same_as<Separator, char> || std::same_as<Separator, std::string_view>
+    constexpr typename split_view<Separator>::iterator& split_view<Separator>::iterator::operator++() {
+        if (tokenEnd == s.size()) {
+            // no separator after the last element
+            tokenBegin = std::string_view::npos;
+            tokenEnd = std::string_view::npos;
+        }
+        else {
+            findToken(tokenEnd + separatorSize());
+        }
+        return *this;
+    }
+
+
+    template<typename Separator>
+        requires std::same_as<Separator, char> || std::same_as<Separator, std::string_view>
+    constexpr void split_view<Separator>::iterator::findToken(size_t pos) {
+        while (true) {
+            size_t posEnd = s.find(separator, pos);
+            if (posEnd == std::string_view::npos) { posEnd = s.size(); }
+            if (skipEmptyStrings and posEnd == pos) {
+                if (posEnd == s.size()) {
+                    tokenBegin = std::string_view::npos;
+                    tokenEnd = std::string_view::npos;
+                    return;
+                }
+                pos = posEnd + separatorSize();
+                continue;
+            }
+            tokenBegin = pos;
+            tokenEnd = posEnd;
+            return;
+        }
+    }
 } // namespace gz::util
 
+template<typename Separator>
+inline constexpr bool std::ranges::enable_borrowed_range<gz::util::split_view<Separator>> = true;
+
 /**
  * @file
  * @brief Contains utility for strings
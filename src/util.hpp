@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <cstring>
+#include <type_traits>
 
 
 namespace gz::util {
@@ -58,6 +61,22 @@ namespace gz::util {
         return i;
     }
 
+//
+// MEMORY UTILITY
+//
+    /**
+     * @brief Copy n elements from src to dst, using a single memcpy if T is trivially copyable
+     * @warning The ranges must not overlap
+     */
+    template<typename T>
+    inline void copyElements(const T* src, std::size_t n, T* dst) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n > 0) { std::memcpy(dst, src, n * sizeof(T)); }
+        }
+        else {
+            std::copy(src, src + n, dst);
+        }
+    }
 
 } // namespace gz::util
 
@@ -0,0 +1,62 @@
+/**
+ * @file
+ * @brief Compares the speed of isInt and isFloat with std::regex_match on re::types::intT and re::types::floatT
+ */
+#include "string/conversion.hpp"
+#include "regex.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gz;
+
+namespace {
+    constexpr size_t FIELD_COUNT = 100000;
+    constexpr size_t REPETITIONS = 5;
+
+    /// @returns Nanoseconds per field and the number of accepted fields
+    template<typename F>
+    std::pair<double, size_t> benchmark(const std::vector<std::string>& fields, F&& f) {
+        size_t accepted = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < REPETITIONS; r++) {
+            for (const auto& field : fields) {
+                accepted += f(field);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        return { std::chrono::duration<double, std::nano>(end - start).count() / (REPETITIONS * fields.size()), accepted };
+    }
+}
+
+int main() {
+    // a mix of fields like they appear in a csv or config file
+    std::mt19937 rng(1);
+    std::vector<std::string> fields;
+    fields.reserve(FIELD_COUNT);
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        switch (i % 5) {
+            case 0: fields.push_back(std::to_string(rng())); break;
+            case 1: fields.push_back(std::to_string(rng() * 1e-3)); break;
+            case 2: fields.push_back("-1.5e" + std::to_string(i % 300)); break;
+            case 3: fields.push_back("0x" + std::to_string(rng() % 100000)); break;
+            default: fields.push_back("name_" + std::to_string(i)); break;
+        }
+    }
+
+    auto [regexInt, regexIntCount] = benchmark(fields, [](const std::string& s) { return std::regex_match(s, re::types::intT); });
+    auto [scanInt, scanIntCount] = benchmark(fields, [](const std::string& s) { return isInt(s); });
+    auto [regexFloat, regexFloatCount] = benchmark(fields, [](const std::string& s) { return std::regex_match(s, re::types::floatT); });
+    auto [scanFloat, scanFloatCount] = benchmark(fields, [](const std::string& s) { return isFloat(s); });
+
+    std::cout << "int:   std::regex_match " << regexInt << " ns/field, isInt " << scanInt << " ns/field, speedup " << regexInt / scanInt << "\n";
+    std::cout << "float: std::regex_match " << regexFloat << " ns/field, isFloat " << scanFloat << " ns/field, speedup " << regexFloat / scanFloat << "\n";
+    if (regexIntCount != scanIntCount or regexFloatCount != scanFloatCount) {
+        std::cerr << "Results differ: int " << regexIntCount << " vs " << scanIntCount << ", float " << regexFloatCount << " vs " << scanFloatCount << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @brief Differential test of isInt, isUInt and isFloat against the regular expressions in re::types
+ */
+#include "string/conversion.hpp"
+#include "regex.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gz;
+
+namespace {
+    size_t mismatches = 0;
+
+    void check(const std::string& s) {
+        const bool isInt_ = isInt(s), intRe = std::regex_match(s, re::types::intT);
+        const bool isUInt_ = isUInt(s), uintRe = std::regex_match(s, re::types::uintT);
+        const bool isFloat_ = isFloat(s), floatRe = std::regex_match(s, re::types::floatT);
+        // the string_view overloads must agree with the std::string overloads
+        const std::string_view sv(s);
+        const bool viewsMatch = isInt(sv) == isInt_ and isUInt(sv) == isUInt_ and isFloat(sv) == isFloat_;
+        if (isInt_ != intRe or isUInt_ != uintRe or isFloat_ != floatRe or !viewsMatch) {
+            if (mismatches++ < 20) {
+                std::cerr << "Mismatch for '" << s << "': "
+                    << "isInt=" << isInt_ << " intT=" << intRe << ", "
+                    << "isUInt=" << isUInt_ << " uintT=" << uintRe << ", "
+                    << "isFloat=" << isFloat_ << " floatT=" << floatRe
+                    << (viewsMatch ? "" : ", string_view overloads differ") << "\n";
+            }
+        }
+    }
+}
+
+int main() {
+    const std::vector<std::string> edgeCases = {
+        "", " ", "+", "-", "+-1", "--1", "0", "-0", "+0", "00", "1", "-1", "+1", " 1", "1 ",
+        "18446744073709551616", "-9223372036854775809", "123456789012345678901234567890",
+        "0x", "0X", "0x1", "-0x1", "+0X1f", "0xg", "0x1p5", "0x1.8p-3", "0x.8", "0x1p", "-0x1.p+2", "0xx1",
+        ".", ".5", "5.", "-.5", "+5.", "..5", "5..", "1.2.3",
+        "e", "e5", "1e", "1e+", "1e-", "1e5", "1E5", "1e+5", "1e-5", ".5e5", "5.e5", "1e5.5", "1e5e5", "1p5",
+        "inf", "INF", "Inf", "-inf", "+inf", "infinity", "INFINITY", "-Infinity", "infinit", "infinityy", "in", "if",
+        "nan", "NaN", "-nan", "nanabc", "nan_1", "nan(1)", "nan-", "na", "-nan123",
+        "1_000", "1'000", "1,5", "\t1", "1\n",
+    };
+    for (const auto& s : edgeCases) {
+        check(s);
+    }
+
+    // random strings from an alphabet relevant to numbers and from concatenated tokens
+    std::mt19937 rng(20240315);
+    const std::string alphabet = "0123456789+-.eEpPxXnNaAiIfFtTyY_z ";
+    const std::vector<std::string> tokens = {
+        "0x", "0X", "inf", "INFINITY", "nan", "NaN", "e", "E", "p", "P", "+", "-", ".",
+        "0", "1", "12345678", "123456789012345", "_", "q", "infinity", "e+", "p-",
+    };
+    constexpr size_t RANDOM_STRINGS = 1000000;
+    for (size_t i = 0; i < RANDOM_STRINGS; i++) {
+        std::string s;
+        if (i % 2 == 0) {
+            const size_t length = rng() % 14;
+            for (size_t j = 0; j < length; j++) {
+                s += alphabet[rng() % alphabet.size()];
+            }
+        }
+        else {
+            const size_t tokenCount = rng() % 5;
+            for (size_t j = 0; j < tokenCount; j++) {
+                s += tokens[rng() % tokens.size()];
+            }
+        }
+        check(s);
+    }
+
+    const size_t total = edgeCases.size() + RANDOM_STRINGS;
+    if (mismatches > 0) {
+        std::cerr << "number_validation_test: " << mismatches << " of " << total << " strings mismatched\n";
+        return 1;
+    }
+    std::cout << "number_validation_test: " << total << " strings, no mismatches\n";
+    return 0;
+}
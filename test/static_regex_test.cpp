@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @brief Differential test of re::static_regex against std::regex
+ */
+#include "regex.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gz;
+
+namespace {
+    size_t mismatches = 0;
+    size_t checks = 0;
+
+    /// Compare match() and search() with std::regex_match and std::regex_search for every input
+    template<re::fixed_string Pattern, std::regex::flag_type Flags=std::regex::ECMAScript>
+    void checkPattern(const std::vector<std::string>& inputs) {
+        using Regex = re::static_regex<Pattern, Flags>;
+        const std::regex stdRegex(std::string(Pattern.view()), Flags);
+        for (const auto& s : inputs) {
+            const bool match = Regex::match(s), stdMatch = std::regex_match(s, stdRegex);
+            const bool search = Regex::search(s), stdSearch = std::regex_search(s, stdRegex);
+            const bool found = Regex::find(s).has_value();
+            // the svmatch overloads must find the same full match, which may be longer since static_regex finds the longest one.
+            // Groups do not capture, so m.size() is not compared
+            re::svmatch m, stdM;
+            const std::string_view sv(s);
+            bool svmatchDiffers = re::regex_match(sv, m, Regex()) != re::regex_match(sv, stdM, stdRegex) or m.empty() != stdM.empty() or
+                (!m.empty() and m.str(0) != stdM.str(0));
+            svmatchDiffers = svmatchDiffers or re::regex_search(sv, m, Regex()) != re::regex_search(sv, stdM, stdRegex) or m.empty() != stdM.empty() or
+                (!m.empty() and (m.position(0) != stdM.position(0) or m.length(0) < stdM.length(0) or m.suffix().first != m[0].second));
+            checks++;
+            if (match != stdMatch or search != stdSearch or found != stdSearch or svmatchDiffers) {
+                if (mismatches++ < 20) {
+                    std::cerr << "Mismatch for pattern '" << Pattern.view() << "'" << ((Flags & std::regex::icase) ? " (icase)" : "")
+                        << " and '" << s << "': "
+                        << "match=" << match << " std=" << stdMatch << ", "
+                        << "search=" << search << " find=" << found << " std=" << stdSearch
+                        << (svmatchDiffers ? ", svmatch differs" : "") << "\n";
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    std::vector<std::string> inputs = {
+        "", "a", "A", "b", "B", "aA", "Aa", "abc", "ABC", "aBc", "x", "X", "xyz", "XYZ", "q", "Q", "_", "1", "-", " ", "\n",
+        "-42", "+0x1F", "1.5e3", "INF", "nanX", "foobar", "FOOBAR", "a\nz", "az", "AZ", "xx", "xxx", "xxxx",
+    };
+    std::mt19937 rng(42);
+    const std::string alphabet = "aAbBcCxXyYzZqQ019_-+. \n";
+    for (size_t i = 0; i < 20000; i++) {
+        std::string s;
+        const size_t length = rng() % 8;
+        for (size_t j = 0; j < length; j++) {
+            s += alphabet[rng() % alphabet.size()];
+        }
+        inputs.push_back(s);
+    }
+
+    // negated classes and escapes, which must be case folded before they are negated
+    checkPattern<"[^a]", std::regex::icase>(inputs);
+    checkPattern<"[^a]">(inputs);
+    checkPattern<"[^a-c]+", std::regex::icase>(inputs);
+    checkPattern<"[^A-Z]*x", std::regex::icase>(inputs);
+    checkPattern<"a[^B]c", std::regex::icase>(inputs);
+    checkPattern<"[^xyz]?q">(inputs);
+    checkPattern<"[^xyz]?q", std::regex::icase>(inputs);
+    checkPattern<R"([^\d])", std::regex::icase>(inputs);
+    checkPattern<R"([^\W]+)", std::regex::icase>(inputs);
+    checkPattern<R"(\D\S)", std::regex::icase>(inputs);
+    checkPattern<R"(\W+)", std::regex::icase>(inputs);
+    checkPattern<R"([^\s_]+)", std::regex::icase>(inputs);
+
+    // other syntax
+    checkPattern<R"([+\-]?\d+)">(inputs);
+    checkPattern<"(ab|a)*b">(inputs);
+    checkPattern<"(ab|a)*b", std::regex::icase>(inputs);
+    checkPattern<"^a.*z$">(inputs);
+    checkPattern<"x{2,3}">(inputs);
+    checkPattern<"^x{2}$">(inputs);
+    checkPattern<"(?:foo|bar)+", std::regex::icase>(inputs);
+    checkPattern<"[a-f0-9]{2}">(inputs);
+    checkPattern<"a?b?c?">(inputs);
+    checkPattern<R"([+\-]?(((\d+\.?\d*)|(\d*\.?\d+))(e[+\-]?\d+)?)|(inf(inity)?)|(nan\w*)|((0x|0X)((\d+\.?\d*)|(\d*\.?\d+))(p[+\-]?\d+)?))", std::regex::icase>(inputs);
+
+    if (mismatches > 0) {
+        std::cerr << "static_regex_test: " << mismatches << " of " << checks << " checks mismatched\n";
+        return 1;
+    }
+    std::cout << "static_regex_test: " << checks << " checks, no mismatches\n";
+    return 0;
+}